@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AtomicFenwickTree.hpp"
+#include "FenwickTree.hpp"
+#include "bench.h"
+
+using namespace mystd::fenwick_tree;
+
+namespace {
+const int OPS_PER_THREAD = 1 << 20;
+const int ARR_SIZE = 1 << 16;
+
+// 所有写线程共享一把锁，作为对照组
+class LockedFenwickTree {
+private:
+  std::mutex mutex_;
+  BasicFenwickTree<group::Sum<uint64_t>> tree_{ARR_SIZE};
+
+public:
+  void apply(int ind, uint64_t val) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tree_.apply(ind, val);
+  }
+  auto query(int ind) -> uint64_t {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tree_.query(ind);
+  }
+};
+
+// threads 个写线程做单点修改，同时一个读线程不断查询整体前缀和
+template <typename Apply, typename Query>
+auto runWriters(int threads, Apply apply, Query query) -> double {
+  std::atomic<bool> done{false};
+  std::thread reader([&]() {
+    uint64_t checksum = 0;
+    while (!done.load(std::memory_order_relaxed)) {
+      checksum += query(ARR_SIZE - 1);
+    }
+    doNotOptimize(checksum);
+  });
+  std::vector<std::thread> workers;
+  Stopwatch watch;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&apply, t]() {
+      uint64_t state = 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(t);
+      for (int i = 0; i < OPS_PER_THREAD; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        apply(t, static_cast<int>(state % ARR_SIZE), 1);
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  double elapsed = watch.elapsedMs();
+  done.store(true, std::memory_order_relaxed);
+  reader.join();
+  return elapsed;
+}
+}  // namespace
+
+// 全局锁、原子单元格、按线程分片三种方案随写线程数的扩展性
+MAKE_BENCH(AtomicFenwickTree, WriterScaling) {
+  unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= hardware * 2; threads *= 2) {
+    int count = static_cast<int>(threads);
+    size_t ops = static_cast<size_t>(threads) * OPS_PER_THREAD;
+    std::string suffix = ", " + std::to_string(threads) + " writers";
+    LockedFenwickTree locked;
+    report("mutex + BasicFenwickTree" + suffix,
+           runWriters(
+               count,
+               [&](int, int ind, uint64_t val) { locked.apply(ind, val); },
+               [&](int ind) { return locked.query(ind); }),
+           ops);
+    AtomicFenwickTree<uint64_t> atomic_tree(ARR_SIZE);
+    report("AtomicFenwickTree" + suffix,
+           runWriters(
+               count,
+               [&](int, int ind, uint64_t val) { atomic_tree.apply(ind, val); },
+               [&](int ind) { return atomic_tree.query(ind); }),
+           ops);
+    ShardedFenwickTree<uint64_t> sharded(ARR_SIZE, threads);
+    report("ShardedFenwickTree" + suffix,
+           runWriters(
+               count,
+               [&](int t, int ind, uint64_t val) {
+                 sharded.apply(static_cast<size_t>(t), ind, val);
+               },
+               [&](int ind) { return sharded.query(ind); }),
+           ops);
+  }
+}
@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BlockedFenwickTree.hpp"
+#include "FenwickTree.hpp"
+#include "bench.h"
+
+using namespace mystd::fenwick_tree;
+
+namespace {
+const int OPS = 1 << 22;
+
+// 先在随机下标上做 OPS 次单点修改，再做 OPS 次前缀查询，两者分别计时
+template <typename Tree>
+void runRandom(const std::string &label, Tree &tree) {
+  const int64_t arr_size = tree.size();
+  std::mt19937 rng(7);
+  std::vector<int64_t> inds(OPS);
+  for (auto &ind : inds) {
+    ind = static_cast<int64_t>(rng() % arr_size);
+  }
+  Stopwatch apply_watch;
+  for (int i = 0; i < OPS; i++) {
+    tree.apply(inds[i], static_cast<uint64_t>(i));
+  }
+  report(label + " apply", apply_watch.elapsedMs(), OPS);
+  uint64_t checksum = 0;
+  Stopwatch query_watch;
+  for (int i = 0; i < OPS; i++) {
+    checksum += tree.query(inds[i]);
+  }
+  report(label + " query", query_watch.elapsedMs(), OPS);
+  doNotOptimize(checksum);
+}
+}  // namespace
+
+// 数据远大于缓存时，普通布局每个节点独占一条缓存行，上层节点也会缺失；
+// 分块布局每层一条缓存行，n = 2^26、BLOCK = 8 时共 9 层，只有最底下两层
+// 超出缓存。BLOCK 越大层数越少，查询越快，但单点修改每层要改 BLOCK 个格子
+// 每棵 uint64 树约占 8n 字节，n = 2^30 需要 8 GiB 以上的内存，这里取到 2^26
+MAKE_BENCH(FenwickTree, BlockedLayout) {
+  for (int arr_size : {1 << 20, 1 << 23, 1 << 26}) {
+    std::cout << "  n = " << arr_size << "\n";
+    {
+      BasicFenwickTree<group::Sum<uint64_t>> plain(arr_size);
+      runRandom("BasicFenwickTree", plain);
+    }
+    {
+      BlockedFenwickTree<group::Sum<uint64_t>> blocked(arr_size);
+      runRandom("BlockedFenwickTree", blocked);
+    }
+    {
+      BlockedFenwickTree<group::Sum<uint64_t>, 16> blocked(arr_size);
+      runRandom("BlockedFenwickTree<16>", blocked);
+    }
+  }
+}
@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FenwickTree.hpp"
+#include "bench.h"
+
+using namespace mystd::fenwick_tree;
+
+namespace {
+const int OPS = 1 << 22;
+const uint64_t MOD = 998244353;
+
+auto zero() -> uint64_t { return 0; }
+auto add(uint64_t lhs, uint64_t rhs) -> uint64_t { return lhs + rhs; }
+auto sub(uint64_t lhs, uint64_t rhs) -> uint64_t { return lhs - rhs; }
+auto addMod(uint64_t lhs, uint64_t rhs) -> uint64_t {
+  return (lhs + rhs) % MOD;
+}
+auto subMod(uint64_t lhs, uint64_t rhs) -> uint64_t {
+  return (lhs + MOD - rhs) % MOD;
+}
+
+// 一半单点修改、一半区间查询
+template <typename Tree>
+void runMixed(const std::string &label, Tree &tree) {
+  const int arr_size = tree.size();
+  std::mt19937 rng(42);
+  uint64_t checksum = 0;
+  Stopwatch watch;
+  for (int i = 0; i < OPS; i++) {
+    int ind = static_cast<int>(rng() % arr_size);
+    if ((i & 1) == 0) {
+      tree.apply(ind, static_cast<uint64_t>(i) % MOD);
+    } else {
+      checksum += tree.query(ind);
+    }
+  }
+  report(label, watch.elapsedMs(), OPS);
+  doNotOptimize(checksum);
+}
+}  // namespace
+
+// 函数指针模板参数与群类型参数的对比：后者的运算对编译器完全可见
+// 小规模时数据在缓存内，差异主要来自运算本身；大规模时以访存为主
+MAKE_BENCH(FenwickTree, FunctionPointerVersusGroup) {
+  for (int arr_size : {1 << 12, 1 << 20}) {
+    std::cout << "  n = " << arr_size << "\n";
+    FenwickTree<uint64_t, zero, add, sub> fp_sum(arr_size);
+    runMixed("function pointer sum", fp_sum);
+    BasicFenwickTree<group::Sum<uint64_t>> group_sum(arr_size);
+    runMixed("group::Sum", group_sum);
+    FenwickTree<uint64_t, zero, addMod, subMod> fp_mod(arr_size);
+    runMixed("function pointer mod sum (%)", fp_mod);
+    BasicFenwickTree<group::ModSum> group_mod(arr_size, group::ModSum(MOD));
+    runMixed("group::ModSum (runtime modulus)", group_mod);
+  }
+}
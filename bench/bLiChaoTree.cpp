@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "LiChaoTree.hpp"
+#include "bench.h"
+
+using namespace mystd::segment_tree;
+
+namespace {
+const int OPS = 1 << 21;
+// 每条线段在动态版本中最多新建约 2 log C 个节点，C = 2^41 时 2^21 条线段
+// 需要数 GiB 内存，因此线段只插入 2^18 条
+const int SEGMENT_OPS = 1 << 18;
+
+// 先插入直线（或线段），再做 OPS 次随机点查询
+template <typename Tree>
+void runTree(const std::string &label, Tree &tree, bool segments) {
+  const int64_t lo = tree.lo();
+  const auto width = static_cast<uint64_t>(tree.hi()) - lo;
+  std::mt19937_64 rng(17);
+  auto random_pos = [&]() {
+    return static_cast<int64_t>(lo + static_cast<int64_t>(rng() % width));
+  };
+  const int inserts = segments ? SEGMENT_OPS : OPS;
+  Stopwatch watch;
+  for (int i = 0; i < inserts; i++) {
+    Line<int64_t> line{static_cast<int64_t>(rng() % 2001) - 1000,
+                       static_cast<int64_t>(rng() % 2000001) - 1000000};
+    if (segments) {
+      int64_t l = random_pos();
+      int64_t r = random_pos();
+      tree.addSegment(l < r ? l : r, l < r ? r : l, line);
+    } else {
+      tree.addLine(line);
+    }
+  }
+  report(label + (segments ? " addSegment" : " addLine"), watch.elapsedMs(),
+         inserts);
+  int64_t checksum = 0;
+  watch.reset();
+  for (int i = 0; i < OPS; i++) {
+    checksum += tree.query(random_pos());
+  }
+  report(label + " query", watch.elapsedMs(), OPS);
+  doNotOptimize(checksum);
+}
+}  // namespace
+
+// 稠密版本为隐式堆布局，动态版本沿指针（32 位下标）向下走
+MAKE_BENCH(LiChaoTree, Dense) {
+  for (bool segments : {false, true}) {
+    LiChaoTree<int64_t> tree(0, 1 << 20, INT64_MAX);
+    runTree("LiChaoTree, C = 2^20", tree, segments);
+  }
+}
+MAKE_BENCH(LiChaoTree, Dynamic) {
+  for (bool segments : {false, true}) {
+    DynamicLiChaoTree<int64_t> small(0, 1 << 20, INT64_MAX);
+    runTree("DynamicLiChaoTree, C = 2^20", small, segments);
+    DynamicLiChaoTree<int64_t> wide(-(int64_t{1} << 40), int64_t{1} << 40,
+                                    INT64_MAX);
+    runTree("DynamicLiChaoTree, C = 2^41", wide, segments);
+    std::cout << "  nodes: " << wide.nodeCount() << "\n";
+  }
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BinaryHeap.hpp"
+#include "FenwickTree.hpp"
+#include "MultiQueue.hpp"
+#include "bench.h"
+
+using namespace mystd::multi_queue;
+
+namespace {
+const int OPS_PER_THREAD = 1 << 18;
+const int PREFILL = 1 << 16;
+
+// 所有线程共享一把锁的严格优先队列，作为对照组
+class LockedHeap {
+private:
+  std::mutex mutex_;
+  mystd::binary_heap::BinaryHeap<int> heap_;
+
+public:
+  void push(int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    heap_.push(value);
+  }
+  auto tryPop(int &out) -> bool {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (heap_.empty()) {
+      return false;
+    }
+    out = heap_.top();
+    heap_.pop();
+    return true;
+  }
+};
+
+// 每个线程交替 push / pop，返回总耗时
+template <typename Queue>
+auto runThroughput(Queue &queue, int threads) -> double {
+  for (int i = 0; i < PREFILL; i++) {
+    queue.push(i);
+  }
+  std::vector<std::thread> workers;
+  Stopwatch watch;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&queue, t]() {
+      std::mt19937 rng(t);
+      int out = 0;
+      for (int i = 0; i < OPS_PER_THREAD; i++) {
+        queue.push(static_cast<int>(rng() >> 1));
+        queue.tryPop(out);
+      }
+      doNotOptimize(out);
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return watch.elapsedMs();
+}
+
+int zero() { return 0; }
+int add(int lhs, int rhs) { return lhs + rhs; }
+int sub(int lhs, int rhs) { return lhs - rhs; }
+}  // namespace
+
+MAKE_BENCH(MultiQueue, Throughput) {
+  unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= hardware * 2; threads *= 2) {
+    size_t ops = static_cast<size_t>(threads) * OPS_PER_THREAD * 2;
+    LockedHeap locked;
+    report("locked BinaryHeap, " + std::to_string(threads) + " threads",
+           runThroughput(locked, static_cast<int>(threads)), ops);
+    MultiQueue<int> relaxed(threads);
+    report("MultiQueue, " + std::to_string(threads) + " threads",
+           runThroughput(relaxed, static_cast<int>(threads)), ops);
+  }
+}
+
+// 单线程依次取空队列，统计每次取出的元素在剩余元素中的排名（0 表示严格最优）
+MAKE_BENCH(MultiQueue, RankError) {
+  const int count = 1 << 18;
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  for (size_t threads : {1, 4, 16}) {
+    for (size_t choices : {2, 4}) {
+      MultiQueue<int> queue(threads, 2, choices);
+      mystd::fenwick_tree::FenwickTree<int, zero, add, sub> remaining(
+          std::vector<int>(count, 1));
+      for (int key : keys) {
+        queue.push(key);
+      }
+      double rank_sum = 0;
+      int rank_max = 0;
+      int out = 0;
+      while (queue.tryPop(out)) {
+        // 比 out 大的剩余元素个数即为排名误差
+        int rank = remaining.query(out, count - 1) - 1;
+        rank_sum += rank;
+        rank_max = std::max(rank_max, rank);
+        remaining.apply(out, -1);
+      }
+      std::cout << "  shards=" << queue.shardCount() << " choices=" << choices
+                << "  mean rank error " << rank_sum / count << ", max "
+                << rank_max << "\n";
+    }
+  }
+}
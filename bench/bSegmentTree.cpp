@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SegmentTree.hpp"
+#include "bench.h"
+
+using namespace mystd::segment_tree;
+
+namespace {
+const int OPS = 1 << 22;
+
+auto add(uint64_t lhs, uint64_t rhs) -> uint64_t { return lhs + rhs; }
+auto zero() -> uint64_t { return 0; }
+// 懒标记不起作用时的占位操作
+struct Dummy {};
+auto mapping(Dummy, uint64_t val) -> uint64_t { return val; }
+auto composition(Dummy, Dummy) -> Dummy { return Dummy{}; }
+auto dummy() -> Dummy { return Dummy{}; }
+
+using LazyTree = SegmentTree<uint64_t, add, zero, Dummy, mapping, composition,
+                             dummy>;
+using PlainTree = MonoidSegmentTree<uint64_t, add, zero>;
+
+// 一半单点赋值、一半区间求和
+template <typename Tree>
+void runMixed(const std::string &label, Tree &tree) {
+  const int64_t arr_size = tree.size();
+  std::mt19937_64 rng(42);
+  uint64_t checksum = 0;
+  Stopwatch watch;
+  for (int i = 0; i < OPS; i++) {
+    auto l = static_cast<int64_t>(rng() % arr_size);
+    auto r = static_cast<int64_t>(rng() % arr_size);
+    if ((i & 1) == 0) {
+      tree.assign(l, static_cast<uint64_t>(i));
+    } else {
+      checksum += l <= r ? tree.query(l, r) : tree.query(r, l);
+    }
+  }
+  report(label, watch.elapsedMs(), OPS);
+  doNotOptimize(checksum);
+}
+
+// 区间加、区间求和，懒标记真正起作用
+struct SumNode {
+  uint64_t sum, len;
+};
+auto sumOp(SumNode lhs, SumNode rhs) -> SumNode {
+  return SumNode{lhs.sum + rhs.sum, lhs.len + rhs.len};
+}
+auto sumE() -> SumNode { return SumNode{0, 0}; }
+auto addMapping(uint64_t add, SumNode node) -> SumNode {
+  return SumNode{node.sum + add * node.len, node.len};
+}
+auto addComposition(uint64_t lhs, uint64_t rhs) -> uint64_t {
+  return lhs + rhs;
+}
+auto addId() -> uint64_t { return 0; }
+using AddTree = SegmentTree<SumNode, sumOp, sumE, uint64_t, addMapping,
+                            addComposition, addId>;
+
+const int READS_PER_THREAD = 1 << 18;
+const int WRITES = 1 << 12;
+
+// readers 个线程做区间查询，同时一个写线程做区间加；返回读线程的总耗时
+// Lock 为 std::mutex 时查询走会 pushDown 的非 const 重载，必须独占；
+// 为 std::shared_mutex 时读线程持共享锁调用 const 重载
+template <typename Lock>
+auto runReaders(AddTree &tree, int readers) -> double {
+  Lock lock;
+  const int64_t arr_size = tree.size();
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < WRITES && !done.load(std::memory_order_relaxed);
+         i++) {
+      auto l = static_cast<int64_t>(rng() % arr_size);
+      auto r = static_cast<int64_t>(rng() % arr_size);
+      std::lock_guard<Lock> guard(lock);
+      tree.apply(std::min(l, r), std::max(l, r), 1);
+    }
+  });
+  std::vector<std::thread> workers;
+  Stopwatch watch;
+  for (int t = 0; t < readers; t++) {
+    workers.emplace_back([&, t]() {
+      std::mt19937_64 rng(static_cast<uint64_t>(t) + 2);
+      uint64_t checksum = 0;
+      for (int i = 0; i < READS_PER_THREAD; i++) {
+        auto l = static_cast<int64_t>(rng() % arr_size);
+        auto r = static_cast<int64_t>(rng() % arr_size);
+        if constexpr (std::is_same_v<Lock, std::shared_mutex>) {
+          std::shared_lock<Lock> guard(lock);
+          checksum += std::as_const(tree).query(std::min(l, r),
+                                                std::max(l, r)).sum;
+        } else {
+          std::lock_guard<Lock> guard(lock);
+          checksum += tree.query(std::min(l, r), std::max(l, r)).sum;
+        }
+      }
+      doNotOptimize(checksum);
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  double elapsed = watch.elapsedMs();
+  done.store(true, std::memory_order_relaxed);
+  writer.join();
+  return elapsed;
+}
+}  // namespace
+
+// 同样的单点赋值 + 区间求和负载，带懒标记的实现需要沿路径 pushDown
+MAKE_BENCH(SegmentTree, LazyVersusMonoid) {
+  for (int arr_size : {1 << 12, 1 << 20}) {
+    std::cout << "  n = " << arr_size << "\n";
+    LazyTree lazy(arr_size);
+    runMixed("SegmentTree (dummy F)", lazy);
+    PlainTree plain(arr_size);
+    runMixed("MonoidSegmentTree", plain);
+  }
+}
+
+// 读多写少：独占锁 + pushDown 查询，对比读写锁 + const 查询
+MAKE_BENCH(SegmentTree, ConcurrentReaders) {
+  const int arr_size = 1 << 16;
+  unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned readers = 1; readers <= hardware * 2; readers *= 2) {
+    size_t ops = static_cast<size_t>(readers) * READS_PER_THREAD;
+    std::string suffix = ", " + std::to_string(readers) + " readers";
+    AddTree exclusive(std::vector<SumNode>(arr_size, SumNode{0, 1}));
+    report("mutex + query" + suffix,
+           runReaders<std::mutex>(exclusive, static_cast<int>(readers)), ops);
+    AddTree shared(std::vector<SumNode>(arr_size, SumNode{0, 1}));
+    report("shared_mutex + const query" + suffix,
+           runReaders<std::shared_mutex>(shared, static_cast<int>(readers)),
+           ops);
+  }
+}
+
+// 按 2 的幂个子树并行建树；单核机器上只能看到线程创建的开销
+MAKE_BENCH(SegmentTree, ParallelBuild) {
+  unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+  for (int arr_size : {1 << 22, 1 << 24}) {
+    std::vector<SumNode> arr(arr_size, SumNode{1, 1});
+    for (unsigned threads = 1; threads <= std::max(4U, hardware);
+         threads *= 2) {
+      Stopwatch watch;
+      AddTree tree(arr, threads);
+      report("build n = " + std::to_string(arr_size) + ", " +
+                 std::to_string(threads) + " threads",
+             watch.elapsedMs(), static_cast<size_t>(arr_size));
+      doNotOptimize(tree.query(0, arr_size - 1).sum);
+    }
+  }
+}
+
+// 随机单点加：逐个调用 apply，对比每批 BATCH 个调用一次 applyBatch
+MAKE_BENCH(SegmentTree, Batch) {
+  const int arr_size = 1 << 20;
+  for (size_t batch : {size_t{64}, size_t{4096}, size_t{1} << 16}) {
+    std::string suffix = ", batch " + std::to_string(batch);
+    std::mt19937_64 rng(7);
+    std::vector<std::pair<int64_t, uint64_t>> updates(OPS);
+    for (auto &item : updates) {
+      item = {static_cast<int64_t>(rng() % arr_size), rng() % 16};
+    }
+    AddTree single(std::vector<SumNode>(arr_size, SumNode{0, 1}));
+    Stopwatch single_watch;
+    for (const auto &item : updates) {
+      single.apply(item.first, item.second);
+    }
+    report("apply one by one" + suffix, single_watch.elapsedMs(), OPS);
+    AddTree batched(std::vector<SumNode>(arr_size, SumNode{0, 1}));
+    Stopwatch batch_watch;
+    for (size_t i = 0; i < updates.size(); i += batch) {
+      batched.applyBatch(std::vector<std::pair<int64_t, uint64_t>>(
+          updates.begin() + static_cast<std::ptrdiff_t>(i),
+          updates.begin() + static_cast<std::ptrdiff_t>(i + batch)));
+    }
+    report("applyBatch" + suffix, batch_watch.elapsedMs(), OPS);
+    doNotOptimize(single.query(0, arr_size - 1).sum +
+                  batched.query(0, arr_size - 1).sum);
+  }
+}
+
+// 重新载入一段连续窗口：逐个 assign 对比一次 assignRange
+MAKE_BENCH(SegmentTree, AssignRange) {
+  const int arr_size = 1 << 20;
+  AddTree tree(std::vector<SumNode>(arr_size, SumNode{0, 1}));
+  for (int window : {64, 4096, 1 << 16}) {
+    std::string suffix = ", window " + std::to_string(window);
+    std::vector<SumNode> values(window, SumNode{1, 1});
+    const int rounds = OPS / window;
+    std::mt19937_64 rng(13);
+    Stopwatch single_watch;
+    for (int i = 0; i < rounds; i++) {
+      auto from = static_cast<int64_t>(rng() % (arr_size - window + 1));
+      for (int j = 0; j < window; j++) {
+        tree.assign(from + j, values[j]);
+      }
+    }
+    report("assign one by one" + suffix, single_watch.elapsedMs(), OPS);
+    rng.seed(13);
+    Stopwatch range_watch;
+    for (int i = 0; i < rounds; i++) {
+      tree.assignRange(static_cast<int64_t>(rng() % (arr_size - window + 1)),
+                       values);
+    }
+    report("assignRange" + suffix, range_watch.elapsedMs(), OPS);
+  }
+  doNotOptimize(tree.query(0, arr_size - 1).sum);
+}
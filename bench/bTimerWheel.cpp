@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "BinaryHeap.hpp"
+#include "Compare.hpp"
+#include "TimerWheel.hpp"
+#include "bench.h"
+
+using namespace mystd::timer_wheel;
+
+namespace {
+const uint32_t TIMER_COUNT = 1U << 20;
+const uint64_t HORIZON = 1ULL << 22;
+const uint64_t STEP = 256;
+
+struct Bump {
+  uint64_t *counter_;
+  void operator()() const { ++*counter_; }
+};
+
+auto makeDeadlines() -> std::vector<uint64_t> {
+  std::mt19937_64 rng(20240601);
+  std::uniform_int_distribution<uint64_t> dist(1, HORIZON);
+  std::vector<uint64_t> deadlines(TIMER_COUNT);
+  for (auto &deadline : deadlines) {
+    deadline = dist(rng);
+  }
+  return deadlines;
+}
+}  // namespace
+
+// 1M 个待触发定时器：全部调度、取消一半、按固定步长推进直到全部触发
+MAKE_BENCH(TimerWheel, VersusBinaryHeap) {
+  auto deadlines = makeDeadlines();
+  uint64_t fired = 0;
+
+  {
+    TimerWheel<Bump> wheel;
+    std::vector<TimerHandle> handles(TIMER_COUNT);
+    Stopwatch watch;
+    for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+      handles[i] = wheel.schedule(deadlines[i], Bump{&fired});
+    }
+    report("TimerWheel schedule", watch.elapsedMs(), TIMER_COUNT);
+    watch.reset();
+    for (uint32_t i = 0; i < TIMER_COUNT; i += 2) {
+      wheel.cancel(handles[i]);
+    }
+    report("TimerWheel cancel", watch.elapsedMs(), TIMER_COUNT / 2);
+    watch.reset();
+    for (uint64_t now = STEP; now <= HORIZON; now += STEP) {
+      wheel.advance(now);
+    }
+    report("TimerWheel advance", watch.elapsedMs(), TIMER_COUNT / 2);
+    doNotOptimize(fired);
+  }
+
+  {
+    // 对照组：到期时间的小根堆，取消通过墓碑标记延迟处理
+    using Entry = std::pair<uint64_t, uint32_t>;
+    mystd::binary_heap::BinaryHeap<Entry, mystd::compare::Greater<Entry>> heap;
+    std::vector<char> cancelled(TIMER_COUNT, 0);
+    Stopwatch watch;
+    for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+      heap.push(Entry{deadlines[i], i});
+    }
+    report("BinaryHeap schedule", watch.elapsedMs(), TIMER_COUNT);
+    watch.reset();
+    for (uint32_t i = 0; i < TIMER_COUNT; i += 2) {
+      cancelled[i] = 1;
+    }
+    report("BinaryHeap cancel (tombstone)", watch.elapsedMs(),
+           TIMER_COUNT / 2);
+    watch.reset();
+    Bump bump{&fired};
+    for (uint64_t now = STEP; now <= HORIZON; now += STEP) {
+      while (!heap.empty() && heap.top().first <= now) {
+        if (cancelled[heap.top().second] == 0) {
+          bump();
+        }
+        heap.pop();
+      }
+    }
+    report("BinaryHeap advance", watch.elapsedMs(), TIMER_COUNT / 2);
+    doNotOptimize(fired);
+  }
+}
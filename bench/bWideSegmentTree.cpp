@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "FenwickTree.hpp"
+#include "SegmentTree.hpp"
+#include "WideSegmentTree.hpp"
+#include "bench.h"
+
+using namespace mystd::segment_tree;
+
+namespace {
+const int OPS = 1 << 22;
+
+auto add(int32_t lhs, int32_t rhs) -> int32_t { return lhs + rhs; }
+auto zero() -> int32_t { return 0; }
+using BinaryTree = MonoidSegmentTree<int32_t, add, zero>;
+
+// 区间求和，所有结构使用同一串区间
+template <typename Tree>
+void runQueries(const std::string &label, const Tree &tree) {
+  const int64_t arr_size = tree.size();
+  std::mt19937_64 rng(5);
+  int64_t checksum = 0;
+  Stopwatch watch;
+  for (int i = 0; i < OPS; i++) {
+    auto l = static_cast<int64_t>(rng() % arr_size);
+    auto r = static_cast<int64_t>(rng() % arr_size);
+    checksum += l <= r ? tree.query(l, r) : tree.query(r, l);
+  }
+  report(label + " query", watch.elapsedMs(), OPS);
+  doNotOptimize(checksum);
+}
+}  // namespace
+
+// 静态求和：二叉的 MonoidSegmentTree 每次查询约读 2 log2 n 个节点，
+// 16 叉树只读 2 log16 n 个；更新时二叉树改 log2 n 个节点，
+// 16 叉树改 log16 n 个节点，每个节点为一个缓存行
+// 以 -DMYSTD_ENABLE_AVX2=ON 构建时节点内的更新走 AVX2 分支
+MAKE_BENCH(WideSegmentTree, VersusBinary) {
+  for (int arr_size : {1 << 16, 1 << 24}) {
+    std::cout << "  n = " << arr_size << "\n";
+    std::mt19937_64 rng(9);
+    BinaryTree binary(arr_size);
+    WideSegmentTree<int32_t> wide(arr_size);
+    mystd::fenwick_tree::BasicFenwickTree<
+        mystd::fenwick_tree::group::Sum<int32_t>>
+        fenwick(arr_size);
+    Stopwatch watch;
+    for (int i = 0; i < OPS; i++) {
+      auto ind = static_cast<int64_t>(rng() % arr_size);
+      binary.assign(ind, binary.query(ind) + 1);
+    }
+    report("MonoidSegmentTree update", watch.elapsedMs(), OPS);
+    rng.seed(9);
+    watch.reset();
+    for (int i = 0; i < OPS; i++) {
+      wide.apply(static_cast<int64_t>(rng() % arr_size), 1);
+    }
+    report("WideSegmentTree update", watch.elapsedMs(), OPS);
+    rng.seed(9);
+    watch.reset();
+    for (int i = 0; i < OPS; i++) {
+      fenwick.apply(static_cast<int64_t>(rng() % arr_size), 1);
+    }
+    report("BasicFenwickTree update", watch.elapsedMs(), OPS);
+    runQueries("MonoidSegmentTree", binary);
+    runQueries("WideSegmentTree", wide);
+    runQueries("BasicFenwickTree", fenwick);
+  }
+}
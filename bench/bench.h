@@ -0,0 +1,109 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// 阻止编译器把只为计时而计算的结果优化掉
+template <typename T>
+inline void doNotOptimize(const T &val) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(val) : "memory");
+#else
+  static volatile const T *sink;
+  sink = &val;
+#endif
+}
+
+class Stopwatch {
+private:
+  std::chrono::steady_clock::time_point start_;
+
+public:
+  Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+  void reset() { start_ = std::chrono::steady_clock::now(); }
+  [[nodiscard]] auto elapsedMs() const -> double {
+    auto dur = std::chrono::steady_clock::now() - start_;
+    return std::chrono::duration<double, std::milli>(dur).count();
+  }
+};
+
+// 输出一行结果：总耗时与平均每次操作的耗时
+inline void report(const std::string &label, double elapsed_ms, size_t ops) {
+  std::cout << "  " << std::left << std::setw(40) << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2)
+            << elapsed_ms << " ms";
+  if (ops > 0) {
+    std::cout << std::setw(10) << std::setprecision(2)
+              << elapsed_ms * 1e6 / static_cast<double>(ops) << " ns/op";
+  }
+  std::cout << "\n";
+}
+
+using BenchFunc = void (*)();
+
+struct Benchcase {
+  std::string suite_name_;
+  std::string case_name_;
+  BenchFunc func_;
+};
+
+class BenchRegistry {
+  const std::string RESET = "\033[0m";
+  const std::string CYAN = "\033[36m";
+
+public:
+  static auto instance() -> BenchRegistry & {
+    static BenchRegistry reg;
+    return reg;
+  }
+  void addBench(const std::string &suite, const std::string &name,
+                BenchFunc func) {
+    Benchcase tmp{suite, name, func};
+    benches_[suite].push_back(tmp);
+  }
+  void runSuite(const std::string &name) {
+    auto iter = benches_.find(name);
+    if (iter == benches_.end()) {
+      std::cerr << "[WARN] Unknown suite: " << name << "\n";
+      return;
+    }
+    for (auto &benchcase : iter->second) {
+      std::cout << CYAN << "==== " << iter->first << "/"
+                << benchcase.case_name_ << " ====" << RESET << "\n";
+      benchcase.func_();
+    }
+  }
+  void runAll() {
+    for (auto &suite : benches_) {
+      runSuite(suite.first);
+    }
+  }
+  [[nodiscard]] auto getSuites() const -> std::vector<std::string> {
+    std::vector<std::string> out;
+    out.reserve(benches_.size());
+    for (const auto &suite : benches_) {
+      out.push_back(suite.first);
+    }
+    return out;
+  }
+
+private:
+  std::map<std::string, std::vector<Benchcase>> benches_;
+};
+
+#define MAKE_BENCH(suite_name, case_name)                                 \
+  void suite_name##_##case_name##_bench();                                \
+  static int suite_name##_##case_name##_bench_reg = []() {                \
+    BenchRegistry::instance().addBench(#suite_name, #case_name,           \
+                                       &suite_name##_##case_name##_bench); \
+    return 0;                                                             \
+  }();                                                                    \
+  void suite_name##_##case_name##_bench()
+
+#endif  // BENCH_H
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+int main(int argc, char *argv[]) {
+  std::vector<std::string> suites;
+  bool list_suites = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.rfind("--suite=", 0) == 0) {
+      std::string list = arg.substr(8);  // comma-separated suite names
+      std::stringstream ss(list);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+          suites.push_back(item);
+        }
+      }
+    } else if (arg == "--list-suites") {
+      list_suites = true;
+    } else {
+      std::cerr << "Unknown argument " << arg << "\n";
+      list_suites = true;
+    }
+  }
+
+  if (list_suites) {
+    std::cout << "Registered benchmark suites:\n";
+    for (const auto &suite : BenchRegistry::instance().getSuites()) {
+      std::cout << "- " << suite << "\n";
+    }
+    return 0;
+  }
+
+  if (suites.empty()) {
+    BenchRegistry::instance().runAll();
+  } else {
+    for (const auto &suite : suites) {
+      BenchRegistry::instance().runSuite(suite);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,166 @@
+#ifndef ATOMICFENWICKTREE_HPP
+#define ATOMICFENWICKTREE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "BitOperation.hpp"
+
+namespace mystd::fenwick_tree {
+
+/// INFO: 多写者的整数求和树状数组，单元格为 std::atomic，修改用 relaxed 的
+/// fetch_add。一次单点修改只会落在前缀查询所读单元格中的恰好一个上，因此任意
+/// 前缀查询对每次修改要么完整看到、要么完全看不到；区间查询由两次前缀查询相减
+/// 得到，在并发修改下不是一个原子快照
+template <typename T>
+class AtomicFenwickTree {
+  static_assert(std::is_integral_v<T>,
+                "AtomicFenwickTree requires an integral type");
+
+public:
+  using ValueType = T;
+
+private:
+  int64_t arr_size_;
+  std::vector<std::atomic<T>> tree_;
+
+public:
+  explicit AtomicFenwickTree(int64_t arr_size) : arr_size_(arr_size) {
+    if (arr_size < 0) {
+      throw std::invalid_argument("AtomicFenwickTree requires n >= 0");
+    }
+    tree_ = std::vector<std::atomic<T>>(static_cast<size_t>(arr_size) + 1);
+    for (auto &cell : tree_) {
+      cell.store(0, std::memory_order_relaxed);
+    }
+  }
+  // 数组下标从 0 开始，构造过程不是线程安全的
+  explicit AtomicFenwickTree(const std::vector<T> &arr)
+      : AtomicFenwickTree(static_cast<int64_t>(arr.size())) {
+    for (int64_t i = 1; i <= arr_size_; i++) {
+      T cur = tree_[i].load(std::memory_order_relaxed) + arr[i - 1];
+      tree_[i].store(cur, std::memory_order_relaxed);
+      int64_t parent = i + static_cast<int64_t>(bitop::lowbit(i));
+      if (parent <= arr_size_) {
+        tree_[parent].fetch_add(cur, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+
+  // 可以被任意多个线程同时调用
+  void apply(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("AtomicFenwickTree::apply invalid index");
+    }
+    for (int64_t i = ind + 1; i <= arr_size_;
+         i += static_cast<int64_t>(bitop::lowbit(i))) {
+      tree_[i].fetch_add(val, std::memory_order_relaxed);
+    }
+  }
+  // 此处求和得到的是前缀和
+  auto query(int64_t ind) const -> T {
+    if (ind < -1 || ind >= arr_size_) {
+      throw std::out_of_range("AtomicFenwickTree::query invalid index");
+    }
+    T result = 0;
+    for (int64_t i = ind + 1; i > 0;
+         i -= static_cast<int64_t>(bitop::lowbit(i))) {
+      result += tree_[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("AtomicFenwickTree::query invalid interval");
+    }
+    return query(right_bound) - query(left_bound - 1);
+  }
+};
+
+/// INFO: 按写者分片的整数求和树状数组，查询时把所有分片的结果相加
+/// 每个分片只允许一个线程写，写入是 relaxed 的读-改-写而不是带锁的原子指令，
+/// 不同写者之间也不共享缓存行；代价是查询要读 shards 棵树
+template <typename T>
+class ShardedFenwickTree {
+  static_assert(std::is_integral_v<T>,
+                "ShardedFenwickTree requires an integral type");
+
+public:
+  using ValueType = T;
+
+private:
+  static constexpr size_t CACHE_LINE = 64;
+
+  // 分片对象之间按缓存行对齐，避免分片头部的伪共享
+  struct alignas(CACHE_LINE) Shard {
+    std::vector<std::atomic<T>> tree_;
+  };
+
+  int64_t arr_size_;
+  std::vector<Shard> shards_;
+
+public:
+  ShardedFenwickTree(int64_t arr_size, size_t shards)
+      : arr_size_(arr_size), shards_(shards) {
+    if (shards == 0) {
+      throw std::invalid_argument("ShardedFenwickTree requires shards > 0");
+    }
+    if (arr_size < 0) {
+      throw std::invalid_argument("ShardedFenwickTree requires n >= 0");
+    }
+    for (auto &shard : shards_) {
+      shard.tree_ =
+          std::vector<std::atomic<T>>(static_cast<size_t>(arr_size) + 1);
+      for (auto &cell : shard.tree_) {
+        cell.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  [[nodiscard]] auto shardCount() const -> size_t { return shards_.size(); }
+
+  // 同一分片同一时刻只能有一个线程调用
+  void apply(size_t shard, int64_t ind, T val) {
+    if (shard >= shards_.size() || ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("ShardedFenwickTree::apply invalid index");
+    }
+    auto &tree = shards_[shard].tree_;
+    for (int64_t i = ind + 1; i <= arr_size_;
+         i += static_cast<int64_t>(bitop::lowbit(i))) {
+      tree[i].store(tree[i].load(std::memory_order_relaxed) + val,
+                    std::memory_order_relaxed);
+    }
+  }
+  // 与写者并发时语义同 AtomicFenwickTree::query
+  auto query(int64_t ind) const -> T {
+    if (ind < -1 || ind >= arr_size_) {
+      throw std::out_of_range("ShardedFenwickTree::query invalid index");
+    }
+    T result = 0;
+    for (const auto &shard : shards_) {
+      for (int64_t i = ind + 1; i > 0;
+           i -= static_cast<int64_t>(bitop::lowbit(i))) {
+        result += shard.tree_[i].load(std::memory_order_relaxed);
+      }
+    }
+    return result;
+  }
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("ShardedFenwickTree::query invalid interval");
+    }
+    return query(right_bound) - query(left_bound - 1);
+  }
+};
+}  // namespace mystd::fenwick_tree
+
+#endif  // ATOMICFENWICKTREE_HPP
@@ -4,21 +4,49 @@
 namespace mystd::bitop {
 // NOLINTBEGIN(readability-identifier-naming, readability-identifier-length)
 using ull = unsigned long long;
+// 结果超出 64 位时返回 0
 constexpr auto bitCeil(ull n) noexcept -> ull {
   ull x = 1;
-  while (x < n) {
+  while (x != 0 && x < n) {
     x <<= 1;
   }
   return x;
 }
+// n 为 0 时返回 64
 constexpr auto countrZero(ull n) noexcept -> ull {
   ull x = 0;
-  while ((n & (1ULL << x)) == 0U) {
+  while (x < 64 && (n & (1ULL << x)) == 0U) {
     x++;
   }
   return x;
 }
 constexpr auto lowbit(ull n) noexcept -> ull { return n & -n; }
+// 表示 n 所需的二进制位数，n 为 0 时返回 0
+constexpr auto bitWidth(ull n) noexcept -> ull {
+#if defined(__GNUC__) || defined(__clang__)
+  return n == 0 ? 0 : 64 - static_cast<ull>(__builtin_clzll(n));
+#else
+  ull x = 0;
+  while (x < 64 && (n >> x) != 0U) {
+    x++;
+  }
+  return x;
+#endif
+}
+// floor(log2(n))，要求 n > 0
+constexpr auto floorLog(ull n) noexcept -> ull { return bitWidth(n) - 1; }
+// n 的二进制表示中 1 的个数
+constexpr auto popcount(ull n) noexcept -> ull {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<ull>(__builtin_popcountll(n));
+#else
+  ull x = 0;
+  for (; n != 0; n &= n - 1) {
+    x++;
+  }
+  return x;
+#endif
+}
 // NOLINTEND(readability-identifier-naming, readability-identifier-length)
 }  // namespace mystd::bitop
 
@@ -0,0 +1,189 @@
+#ifndef BLOCKEDFENWICKTREE_HPP
+#define BLOCKEDFENWICKTREE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "FenwickTree.hpp"
+
+namespace mystd::fenwick_tree {
+
+/// INFO: 面向超大规模数据的多层分块树状数组，接口与 BasicFenwickTree 相同
+/// 每层按缓存行切成大小为 BLOCK 的块，块内存该块的前缀和；第 k + 1 层的元素是
+/// 第 k 层各块的总和，如此直到某一层只剩一个块，共 log_BLOCK n 层
+/// 前缀查询每层读一个格子，单点修改每层改同一条缓存行里的若干格子，
+/// 每次操作每层只访问一条缓存行；第 k 层只有 n / BLOCK^k 个格子，
+/// 除最底下几层外都能留在缓存中，缓存缺失约为 log_BLOCK(n / 缓存大小) 次，
+/// 而普通布局约为 log2(n / 缓存大小) / 2 次
+/// 块内的前缀和要求 op 满足交换律（树状数组本身同样要求）
+template <typename Group, size_t BLOCK = 0>
+class BlockedFenwickTree {
+public:
+  using ValueType = typename Group::ValueType;
+
+private:
+  using T = ValueType;
+  static constexpr size_t CACHE_LINE = 64;
+  // 默认让一个块恰好占满一条缓存行
+  static constexpr size_t BLOCK_SIZE =
+      BLOCK != 0 ? BLOCK
+                 : (sizeof(T) >= CACHE_LINE / 2 ? 2 : CACHE_LINE / sizeof(T));
+  static_assert(BLOCK_SIZE >= 2 && (BLOCK_SIZE & (BLOCK_SIZE - 1)) == 0,
+                "BlockedFenwickTree block size must be a power of two >= 2");
+  static constexpr auto B = static_cast<int64_t>(BLOCK_SIZE);
+
+  // cells_[j] 为块内第 0 到第 j 个元素的和，超出数组的位置与最后一个相同
+  struct alignas(CACHE_LINE) Block {
+    std::array<T, BLOCK_SIZE> cells_;
+  };
+
+  // 块数每层至少缩小为 1 / 2，64 层足够
+  static constexpr int MAX_LEVELS = 64;
+
+  int64_t arr_size_;
+  int levels_ = 0;
+  // 所有层的块连续存放，第 k 层从 blocks_[offset_[k]] 开始；
+  // 第 0 层为原数组，最后一层只有一个块
+  std::array<int64_t, MAX_LEVELS + 1> offset_{};
+  std::vector<Block> blocks_;
+  Group group_;
+
+  // 用 elems 建一层，返回这一层每块的总和
+  auto buildLevel(const std::vector<T> &elems) -> std::vector<T> {
+    auto count = static_cast<int64_t>(elems.size());
+    int64_t block_count = count == 0 ? 1 : (count + B - 1) / B;
+    offset_[levels_ + 1] = offset_[levels_] + block_count;
+    blocks_.resize(static_cast<size_t>(offset_[levels_ + 1]));
+    std::vector<T> totals(static_cast<size_t>(block_count));
+    for (int64_t b = 0; b < block_count; b++) {
+      Block &block = blocks_[offset_[levels_] + b];
+      T sum = group_.identity();
+      for (int64_t j = 0; j < B; j++) {
+        if (b * B + j < count) {
+          sum = group_.op(sum, elems[b * B + j]);
+        }
+        block.cells_[j] = sum;
+      }
+      totals[b] = sum;
+    }
+    levels_++;
+    return totals;
+  }
+
+public:
+  explicit BlockedFenwickTree(int64_t arr_size, const Group &group = Group())
+      : BlockedFenwickTree(
+            std::vector<T>(arr_size < 0 ? 0 : static_cast<size_t>(arr_size),
+                           group.identity()),
+            group) {
+    if (arr_size < 0) {
+      throw std::invalid_argument("BlockedFenwickTree requires n >= 0");
+    }
+  }
+  // 数组下标从 0 开始
+  explicit BlockedFenwickTree(const std::vector<T> &arr,
+                              const Group &group = Group())
+      : arr_size_(static_cast<int64_t>(arr.size())), group_(group) {
+    int64_t total_blocks = 1;
+    for (int64_t count = arr_size_; count > B; count = (count + B - 1) / B) {
+      total_blocks += (count + B - 1) / B;
+    }
+    blocks_.reserve(static_cast<size_t>(total_blocks));
+    std::vector<T> totals = buildLevel(arr);
+    while (totals.size() > 1) {
+      totals = buildLevel(totals);
+    }
+  }
+
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  [[nodiscard]] static constexpr auto blockSize() -> size_t {
+    return BLOCK_SIZE;
+  }
+  // 层数，即每次操作访问的缓存行数
+  [[nodiscard]] auto levels() const -> int { return levels_; }
+
+  void apply(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("FenwickTree::apply invalid index");
+    }
+    // addend 前半为单位元、后半为 val，从中截取长为 BLOCK 的窗口，
+    // 使块内位置之前的格子加单位元、之后的加 val：循环次数固定且无分支，
+    // 可以向量化，也不会因块内位置随机而分支预测失败
+    std::array<T, 2 * BLOCK_SIZE> addend;
+    for (int64_t j = 0; j < B; j++) {
+      addend[j] = group_.identity();
+      addend[B + j] = val;
+    }
+    for (int k = 0; k < levels_; k++) {
+      Block &block = blocks_[offset_[k] + ind / B];
+      const T *window = addend.data() + (B - ind % B);
+      for (int64_t j = 0; j < B; j++) {
+        block.cells_[j] = group_.op(block.cells_[j], window[j]);
+      }
+      ind /= B;
+    }
+  }
+
+  // 此处求和得到的是前缀和：本层块内的前缀，加上更高一层中之前各块的前缀
+  auto query(int64_t ind) const -> T {
+    if (ind < -1 || ind >= arr_size_) {
+      throw std::out_of_range("FenwickTree::query invalid index");
+    }
+    T result = group_.identity();
+    // 总是走完所有层，前缀已取完（ind < 0）的层读 0 号格子并代之以单位元，
+    // 避免循环出口随下标随机而分支预测失败
+    for (int k = 0; k < levels_; k++) {
+      int64_t pos = ind < 0 ? 0 : ind;
+      const T &cell = blocks_[offset_[k] + pos / B].cells_[pos % B];
+      result = group_.op(result, ind < 0 ? group_.identity() : cell);
+      ind = ind / B - 1;
+    }
+    return result;
+  }
+
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("FenwickTree::query invalid interval");
+    }
+    return group_.inv(query(right_bound), query(left_bound - 1));
+  }
+
+  // 要求同 BasicFenwickTree::lowerBound：自顶向下每层在一个块内顺序查找
+  auto lowerBound(T target) const -> int64_t {
+    return bound([&](const T &sum) { return !(sum < target); });
+  }
+  auto upperBound(T target) const -> int64_t {
+    return bound([&](const T &sum) { return target < sum; });
+  }
+
+private:
+  // 第一个使 found(query(ind)) 成立的下标，不存在时返回 size()
+  template <typename Pred>
+  auto bound(Pred found) const -> int64_t {
+    T base = group_.identity();
+    int64_t ind = 0;
+    for (int k = levels_ - 1; k >= 0; k--) {
+      const Block &block = blocks_[offset_[k] + ind];
+      int64_t j = 0;
+      while (j < B && !found(group_.op(base, block.cells_[j]))) {
+        j++;
+      }
+      if (j == B) {
+        return arr_size_;
+      }
+      if (j > 0) {
+        base = group_.op(base, block.cells_[j - 1]);
+      }
+      // 下一层中对应的块；最底层时即为原数组下标
+      ind = ind * B + j;
+    }
+    return ind < arr_size_ ? ind : arr_size_;
+  }
+};
+}  // namespace mystd::fenwick_tree
+
+#endif  // BLOCKEDFENWICKTREE_HPP
@@ -0,0 +1,208 @@
+#ifndef DYNAMICSEGMENTTREE_HPP
+#define DYNAMICSEGMENTTREE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "BitOperation.hpp"
+#include "Vector.hpp"
+
+namespace mystd::segment_tree {
+
+/// INFO: 动态开点的懒标记线段树，下标范围为 [lo, hi)，可以是任意的 int64_t
+/// 只为修改路径上的节点分配空间，q 次操作占用 O(q log U) 个节点
+/// 节点存放在 mystd::Vector 中，子节点用 32 位下标而不是指针表示
+/// 未被创建的子树中每个位置的值都是 init，其整体的值按宽度预先算好；
+/// 宽度向上取整到 2 的幂（因此 hi - lo 不能超过 2^63），多出来的位置不会被
+/// 任何查询完整覆盖
+template <typename T, T (*op)(T, T), T (*e)(), typename F, T (*mapping)(F, T),
+          F (*composition)(F, F), F (*id)()>
+class DynamicSegmentTree {
+private:
+  using Index = uint32_t;
+  // 0 号节点是哨兵，表示子节点尚未创建
+  static constexpr Index NIL = 0;
+
+  struct Node {
+    T value_;
+    F lazy_;
+    Index left_ = NIL, right_ = NIL;
+    Node(T value, F lazy) : value_(value), lazy_(lazy) {}
+  };
+
+  int64_t lo_, hi_;
+  int height_log_;
+  // width_value_[k] 为宽度 2^k、所有位置都是 init 的区间的值
+  std::vector<T> width_value_;
+  vector::Vector<Node> pool_;
+
+  auto newNode(int level) -> Index {
+    if (pool_.size() > UINT32_MAX) {
+      throw std::length_error("DynamicSegmentTree node pool exhausted");
+    }
+    pool_.emplaceBack(width_value_[level], id());
+    return static_cast<Index>(pool_.size() - 1);
+  }
+  void applyNode(Index ind, F func) {
+    pool_[ind].value_ = mapping(func, pool_[ind].value_);
+    pool_[ind].lazy_ = composition(func, pool_[ind].lazy_);
+  }
+  // level 为节点宽度的对数，level >= 1 时才有子节点
+  void pushDown(Index ind, int level) {
+    if (pool_[ind].left_ == NIL) {
+      Index child = newNode(level - 1);
+      pool_[ind].left_ = child;
+    }
+    if (pool_[ind].right_ == NIL) {
+      Index child = newNode(level - 1);
+      pool_[ind].right_ = child;
+    }
+    F lazy = pool_[ind].lazy_;
+    applyNode(pool_[ind].left_, lazy);
+    applyNode(pool_[ind].right_, lazy);
+    pool_[ind].lazy_ = id();
+  }
+  void pushUp(Index ind) {
+    pool_[ind].value_ =
+        op(pool_[pool_[ind].left_].value_, pool_[pool_[ind].right_].value_);
+  }
+
+  // 节点管辖 [node_left, node_left + 2^level)，均为相对 lo 的偏移
+  void applyRange(Index ind, int level, uint64_t node_left, uint64_t left,
+                  uint64_t right, F func) {
+    uint64_t node_right = node_left + (uint64_t{1} << level);
+    if (left <= node_left && node_right <= right) {
+      applyNode(ind, func);
+      return;
+    }
+    pushDown(ind, level);
+    uint64_t mid = node_left + (uint64_t{1} << (level - 1));
+    if (left < mid) {
+      applyRange(pool_[ind].left_, level - 1, node_left, left, right, func);
+    }
+    if (mid < right) {
+      applyRange(pool_[ind].right_, level - 1, mid, left, right, func);
+    }
+    pushUp(ind);
+  }
+  void assignPoint(Index ind, int level, uint64_t node_left, uint64_t pos,
+                   T val) {
+    if (level == 0) {
+      pool_[ind].value_ = val;
+      return;
+    }
+    pushDown(ind, level);
+    uint64_t mid = node_left + (uint64_t{1} << (level - 1));
+    if (pos < mid) {
+      assignPoint(pool_[ind].left_, level - 1, node_left, pos, val);
+    } else {
+      assignPoint(pool_[ind].right_, level - 1, mid, pos, val);
+    }
+    pushUp(ind);
+  }
+  // 与 SegmentTree 的 const 查询一样，pending 为祖先上标记的复合，不下传
+  auto queryRange(Index ind, int level, uint64_t node_left, uint64_t left,
+                  uint64_t right, F pending) const -> T {
+    uint64_t node_right = node_left + (uint64_t{1} << level);
+    if (ind == NIL) {
+      // 整棵子树都未创建，区间内每个位置都是 init
+      uint64_t from = left > node_left ? left : node_left;
+      uint64_t to = right < node_right ? right : node_right;
+      return mapping(pending, foldInit(to - from));
+    }
+    if (left <= node_left && node_right <= right) {
+      return mapping(pending, pool_[ind].value_);
+    }
+    F child_pending = composition(pending, pool_[ind].lazy_);
+    uint64_t mid = node_left + (uint64_t{1} << (level - 1));
+    if (right <= mid) {
+      return queryRange(pool_[ind].left_, level - 1, node_left, left, right,
+                        child_pending);
+    }
+    if (mid <= left) {
+      return queryRange(pool_[ind].right_, level - 1, mid, left, right,
+                        child_pending);
+    }
+    return op(queryRange(pool_[ind].left_, level - 1, node_left, left, right,
+                         child_pending),
+              queryRange(pool_[ind].right_, level - 1, mid, left, right,
+                         child_pending));
+  }
+  // count 个 init 的和，按二进制拆分
+  auto foldInit(uint64_t count) const -> T {
+    T result = e();
+    for (int k = 0; count != 0; k++, count >>= 1) {
+      if ((count & 1) != 0) {
+        result = op(result, width_value_[k]);
+      }
+    }
+    return result;
+  }
+  auto offset(int64_t ind) const -> uint64_t {
+    return static_cast<uint64_t>(ind) - static_cast<uint64_t>(lo_);
+  }
+
+public:
+  // 覆盖 [lo, hi)，每个位置的初始值为 init
+  DynamicSegmentTree(int64_t lo, int64_t hi, T init = e()) : lo_(lo), hi_(hi) {
+    if (lo >= hi) {
+      throw std::invalid_argument("DynamicSegmentTree requires lo < hi");
+    }
+    uint64_t width = bitop::bitCeil(offset(hi));
+    if (width == 0) {
+      throw std::invalid_argument("DynamicSegmentTree range too wide");
+    }
+    height_log_ = static_cast<int>(bitop::countrZero(width));
+    width_value_.push_back(init);
+    for (int k = 1; k <= height_log_; k++) {
+      width_value_.push_back(op(width_value_.back(), width_value_.back()));
+    }
+    pool_.emplaceBack(e(), id());  // 哨兵
+    newNode(height_log_);          // 根节点为 1 号
+  }
+
+  [[nodiscard]] auto lo() const -> int64_t { return lo_; }
+  [[nodiscard]] auto hi() const -> int64_t { return hi_; }
+  // 已创建的节点数（不含哨兵）
+  [[nodiscard]] auto nodeCount() const -> size_t { return pool_.size() - 1; }
+  void reserve(size_t nodes) { pool_.reserve(nodes + 1); }
+
+  void assign(int64_t ind, T val) {
+    if (ind < lo_ || ind >= hi_) {
+      throw std::out_of_range("DynamicSegmentTree::assign index out of range");
+    }
+    assignPoint(1, height_log_, 0, offset(ind), val);
+  }
+  void apply(int64_t ind, F func) {
+    if (ind < lo_ || ind >= hi_) {
+      throw std::out_of_range("DynamicSegmentTree::apply index out of range");
+    }
+    apply(ind, ind, func);
+  }
+  // 区间为闭区间 [L, R]
+  void apply(int64_t left_bound, int64_t right_bound, F func) {
+    if (left_bound < lo_ || right_bound >= hi_ || left_bound > right_bound) {
+      throw std::out_of_range("DynamicSegmentTree::apply invalid interval");
+    }
+    applyRange(1, height_log_, 0, offset(left_bound), offset(right_bound) + 1,
+               func);
+  }
+  auto query(int64_t ind) const -> T {
+    if (ind < lo_ || ind >= hi_) {
+      throw std::out_of_range("DynamicSegmentTree::query index out of range");
+    }
+    return query(ind, ind);
+  }
+  // 区间为闭区间 [L, R]，查询不创建节点
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < lo_ || right_bound >= hi_ || left_bound > right_bound) {
+      throw std::out_of_range("DynamicSegmentTree::query invalid interval");
+    }
+    return queryRange(1, height_log_, 0, offset(left_bound),
+                      offset(right_bound) + 1, id());
+  }
+};
+}  // namespace mystd::segment_tree
+
+#endif  // DYNAMICSEGMENTTREE_HPP
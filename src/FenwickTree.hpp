@@ -1,66 +1,236 @@
 #ifndef FENWICKTREE_HPP
 #define FENWICKTREE_HPP
 
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "BitOperation.hpp"
 
 namespace mystd::fenwick_tree {
 
-// op: T × T -> T，满足结合律，e 是单位元
-// opInv: 两段前缀和做差
-template <typename T, T (*e)(), T (*op)(T, T), T (*opInv)(T, T)>
-class FenwickTree {
+/// INFO: 树状数组的运算以“群”类型给出，需要提供：
+/// ValueType：元素类型；identity()：单位元；
+/// op(a, b)：满足结合律、交换律的运算；
+/// inv(a, b)：op 的逆运算，即 inv(op(a, b), b) == a
+/// 三个函数既可以是静态成员函数，也可以是普通成员函数（例如携带运行时的模数）
+/// 可选的 times(a, n) 表示 n 个 a 做 op，缺省时由 op 倍增得到
+namespace group {
+template <typename T>
+struct Sum {
+  using ValueType = T;
+  static constexpr auto identity() -> T { return T(); }
+  static constexpr auto op(T lhs, T rhs) -> T { return lhs + rhs; }
+  static constexpr auto inv(T lhs, T rhs) -> T { return lhs - rhs; }
+  static constexpr auto times(T val, uint64_t count) -> T {
+    return val * static_cast<T>(count);
+  }
+};
+
+template <typename T>
+struct Xor {
+  using ValueType = T;
+  static constexpr auto identity() -> T { return T(); }
+  static constexpr auto op(T lhs, T rhs) -> T { return lhs ^ rhs; }
+  static constexpr auto inv(T lhs, T rhs) -> T { return lhs ^ rhs; }
+  static constexpr auto times(T val, uint64_t count) -> T {
+    return (count & 1) != 0 ? val : T();
+  }
+};
+
+// 模意义下的加法，模数在运行时给出且不超过 2^32，元素需在 [0, mod) 内
+// 用比较后条件相减代替取模，编译后是无分支的 cmov
+class ModSum {
+private:
+  uint64_t mod_;
+
+public:
+  using ValueType = uint64_t;
+  explicit ModSum(uint64_t mod = 1000000007) : mod_(mod) {}
+  [[nodiscard]] auto mod() const -> uint64_t { return mod_; }
+  static constexpr auto identity() -> uint64_t { return 0; }
+  [[nodiscard]] auto op(uint64_t lhs, uint64_t rhs) const -> uint64_t {
+    uint64_t sum = lhs + rhs;
+    return sum >= mod_ ? sum - mod_ : sum;
+  }
+  [[nodiscard]] auto inv(uint64_t lhs, uint64_t rhs) const -> uint64_t {
+    return lhs >= rhs ? lhs - rhs : lhs + mod_ - rhs;
+  }
+  [[nodiscard]] auto times(uint64_t val, uint64_t count) const -> uint64_t {
+    return val * (count % mod_) % mod_;
+  }
+};
+
+// 把函数指针形式的 e / op / opInv 包装成群，供 FenwickTree 使用
+template <typename T, T (*e)(), T (*opFunc)(T, T), T (*opInv)(T, T)>
+struct FunctionGroup {
+  using ValueType = T;
+  static auto identity() -> T { return e(); }
+  static auto op(T lhs, T rhs) -> T { return opFunc(lhs, rhs); }
+  static auto inv(T lhs, T rhs) -> T { return opInv(lhs, rhs); }
+};
+
+template <typename Group, typename = void>
+struct HasTimes : std::false_type {};
+
+template <typename Group>
+struct HasTimes<Group, std::void_t<decltype(std::declval<const Group &>().times(
+                           std::declval<typename Group::ValueType>(),
+                           uint64_t()))>> : std::true_type {};
+
+// n 个 val 做 op；群没有提供 times 时用倍增，O(log n) 次 op
+template <typename Group>
+auto times(const Group &grp, typename Group::ValueType val, uint64_t count) ->
+    typename Group::ValueType {
+  if constexpr (HasTimes<Group>::value) {
+    return grp.times(val, count);
+  } else {
+    auto result = grp.identity();
+    for (; count > 0; count >>= 1) {
+      if ((count & 1) != 0) {
+        result = grp.op(result, val);
+      }
+      val = grp.op(val, val);
+    }
+    return result;
+  }
+}
+
+// 逆元，即 inv(identity, val)
+template <typename Group>
+auto negate(const Group &grp, typename Group::ValueType val) ->
+    typename Group::ValueType {
+  return grp.inv(grp.identity(), val);
+}
+}  // namespace group
+
+template <typename Group>
+class BasicFenwickTree {
+public:
+  using ValueType = typename Group::ValueType;
+
 private:
-  int arr_size_;
+  using T = ValueType;
+  int64_t arr_size_;
   std::vector<T> tree_;
+  Group group_;
 
 public:
-  explicit FenwickTree(int arr_size)
-      : FenwickTree(std::vector<T>(arr_size, e())) {}
+  // 下标与长度均为 int64_t，数组长度可以超过 2^31
+  explicit BasicFenwickTree(int64_t arr_size, const Group &group = Group())
+      : arr_size_(arr_size), group_(group) {
+    if (arr_size < 0) {
+      throw std::invalid_argument("FenwickTree requires n >= 0");
+    }
+    tree_.assign(static_cast<size_t>(arr_size) + 1, group_.identity());
+  }
   // 数组下标从0开始，但是平移到1开始
-  explicit FenwickTree(const std::vector<T> &arr)
-      : arr_size_(static_cast<int>(arr.size())), tree_(arr_size_ + 1, e()) {
-    for (int i = 1; i <= arr_size_; i++) {
-      tree_[i] = op(tree_[i], arr[i - 1]);
-      int j = i + static_cast<int>(bitop::lowbit(i));
+  explicit BasicFenwickTree(const std::vector<T> &arr,
+                            const Group &group = Group())
+      : arr_size_(static_cast<int64_t>(arr.size())),
+        tree_(arr.size() + 1, group.identity()),
+        group_(group) {
+    for (int64_t i = 1; i <= arr_size_; i++) {
+      tree_[i] = group_.op(tree_[i], arr[i - 1]);
+      int64_t j = i + static_cast<int64_t>(bitop::lowbit(i));
       if (j <= arr_size_) {
-        tree_[j] = op(tree_[j], tree_[i]);
+        tree_[j] = group_.op(tree_[j], tree_[i]);
       }
     }
   }
 
-  void apply(int ind, T val) {
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  [[nodiscard]] auto capacity() const -> int64_t {
+    return static_cast<int64_t>(tree_.capacity()) - 1;
+  }
+  auto group() const -> const Group & { return group_; }
+
+  void reserve(int64_t capacity) {
+    if (capacity > arr_size_) {
+      tree_.reserve(static_cast<size_t>(capacity) + 1);
+    }
+  }
+  // 在末尾追加一个元素，其余节点不变，均摊 O(1)
+  // 新节点 i 管辖 (i - lowbit(i), i]，即 val 与 i - 1, i - 2, i - 4, ...
+  // 这些比 lowbit(i) 小的子节点的合并
+  void pushBack(T val) {
+    int64_t ind = arr_size_ + 1;
+    auto low = static_cast<int64_t>(bitop::lowbit(ind));
+    T cell = group_.identity();
+    for (int64_t step = low >> 1; step > 0; step >>= 1) {
+      cell = group_.op(cell, tree_[ind - step]);
+    }
+    tree_.push_back(group_.op(cell, val));
+    arr_size_ = ind;
+  }
+
+  void apply(int64_t ind, T val) {
     if (ind < 0 || ind >= arr_size_) {
       throw std::out_of_range("FenwickTree::apply invalid index");
     }
     ind++;
-    for (; ind <= arr_size_; ind += static_cast<int>(bitop::lowbit(ind))) {
-      tree_[ind] = op(tree_[ind], val);
+    for (; ind <= arr_size_; ind += static_cast<int64_t>(bitop::lowbit(ind))) {
+      tree_[ind] = group_.op(tree_[ind], val);
     }
   }
   // 此处求和得到的是前缀和
-  auto query(int ind) const -> T {
+  auto query(int64_t ind) const -> T {
     if (ind < -1 || ind >= arr_size_) {
       throw std::out_of_range("FenwickTree::query invalid index");
     }
     ind++;
-    T result = e();
-    for (; ind > 0; ind -= static_cast<int>(bitop::lowbit(ind))) {
-      result = op(result, tree_[ind]);
+    T result = group_.identity();
+    for (; ind > 0; ind -= static_cast<int64_t>(bitop::lowbit(ind))) {
+      result = group_.op(result, tree_[ind]);
     }
     return result;
   }
 
-  auto query(int left_bound, int right_bound) const -> T {
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
     if (left_bound < 0 || right_bound >= arr_size_ ||
         left_bound > right_bound) {
       throw std::out_of_range("FenwickTree::query invalid interval");
     }
-    return opInv(query(right_bound), query(left_bound - 1));
+    return group_.inv(query(right_bound), query(left_bound - 1));
+  }
+
+  /// INFO: 以下两个二分要求前缀和单调不减（如非负元素的求和），并且 T 支持 <
+  /// 从最高位开始倍增地在树上下降，每层只访问一个节点，O(log n)
+  // 第一个满足 query(ind) >= target 的下标，不存在时返回 size()
+  auto lowerBound(T target) const -> int64_t {
+    return descend([&](const T &sum) { return sum < target; });
+  }
+  // 第一个满足 query(ind) > target 的下标，不存在时返回 size()
+  auto upperBound(T target) const -> int64_t {
+    return descend([&](const T &sum) { return !(target < sum); });
+  }
+
+private:
+  // 找到最长的前缀使 goLeft 仍成立，返回该前缀的长度
+  template <typename Pred>
+  auto descend(Pred goLeft) const -> int64_t {
+    int64_t pos = 0;
+    T acc = group_.identity();
+    auto step = static_cast<int64_t>(bitop::bitCeil(arr_size_ + 1) >> 1);
+    for (; step > 0; step >>= 1) {
+      if (pos + step <= arr_size_) {
+        T next = group_.op(acc, tree_[pos + step]);
+        if (goLeft(next)) {
+          pos += step;
+          acc = next;
+        }
+      }
+    }
+    return pos;
   }
 };
+
+// op: T × T -> T，满足结合律，e 是单位元
+// opInv: 两段前缀和做差
+template <typename T, T (*e)(), T (*op)(T, T), T (*opInv)(T, T)>
+using FenwickTree = BasicFenwickTree<group::FunctionGroup<T, e, op, opInv>>;
 }  // namespace mystd::fenwick_tree
 
 #endif  // FENWICKTREE_HPP
\ No newline at end of file
@@ -0,0 +1,178 @@
+#ifndef FENWICKTREEND_HPP
+#define FENWICKTREEND_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "BitOperation.hpp"
+#include "FenwickTree.hpp"
+
+namespace mystd::fenwick_tree {
+
+/// INFO: D 维树状数组，单点修改、超矩形查询均为 O(log^D n)
+/// 所有维度连续存放在一个行主序的数组中（每一维平移到从 1 开始）
+/// 超矩形查询用容斥把 2^D 个前缀和组合起来，要求 Group 满足交换律
+template <typename Group, size_t D>
+class FenwickTreeND {
+  static_assert(D > 0, "FenwickTreeND requires D > 0");
+
+public:
+  using ValueType = typename Group::ValueType;
+  using Index = std::array<int64_t, D>;
+
+private:
+  using T = ValueType;
+  Index dims_;
+  std::array<size_t, D> strides_;
+  std::vector<T> tree_;
+  Group group_;
+
+  auto initLayout() -> size_t {
+    size_t total = 1;
+    for (size_t dim = D; dim > 0; dim--) {
+      if (dims_[dim - 1] < 0) {
+        throw std::invalid_argument("FenwickTreeND negative dimension");
+      }
+      strides_[dim - 1] = total;
+      total *= static_cast<size_t>(dims_[dim - 1]) + 1;
+    }
+    return total;
+  }
+
+  // 逐维展开的循环，维数是编译期常量，便于编译器内联
+  template <size_t DIM>
+  void applyDim(size_t offset, const Index &ind, T val) {
+    for (int64_t i = ind[DIM] + 1; i <= dims_[DIM];
+         i += static_cast<int64_t>(bitop::lowbit(i))) {
+      size_t cur = offset + static_cast<size_t>(i) * strides_[DIM];
+      if constexpr (DIM + 1 == D) {
+        tree_[cur] = group_.op(tree_[cur], val);
+      } else {
+        applyDim<DIM + 1>(cur, ind, val);
+      }
+    }
+  }
+
+  template <size_t DIM>
+  auto prefixDim(size_t offset, const Index &ind) const -> T {
+    T result = group_.identity();
+    for (int64_t i = ind[DIM] + 1; i > 0;
+         i -= static_cast<int64_t>(bitop::lowbit(i))) {
+      size_t cur = offset + static_cast<size_t>(i) * strides_[DIM];
+      if constexpr (DIM + 1 == D) {
+        result = group_.op(result, tree_[cur]);
+      } else {
+        result = group_.op(result, prefixDim<DIM + 1>(cur, ind));
+      }
+    }
+    return result;
+  }
+
+  void checkIndex(const Index &ind, int64_t lower, const char *msg) const {
+    for (size_t dim = 0; dim < D; dim++) {
+      if (ind[dim] < lower || ind[dim] >= dims_[dim]) {
+        throw std::out_of_range(msg);
+      }
+    }
+  }
+
+public:
+  explicit FenwickTreeND(const Index &dims, const Group &group = Group())
+      : dims_(dims), group_(group) {
+    tree_.assign(initLayout(), group_.identity());
+  }
+  // values 为行主序排列的初始值，O(D·N) 建树
+  FenwickTreeND(const Index &dims, const std::vector<T> &values,
+                const Group &group = Group())
+      : dims_(dims), group_(group) {
+    tree_.assign(initLayout(), group_.identity());
+    size_t cells = 1;
+    for (size_t dim = 0; dim < D; dim++) {
+      cells *= static_cast<size_t>(dims_[dim]);
+    }
+    if (values.size() != cells) {
+      throw std::invalid_argument("FenwickTreeND values size mismatch");
+    }
+    for (size_t flat = 0; flat < cells; flat++) {
+      size_t rest = flat;
+      size_t offset = 0;
+      for (size_t dim = D; dim > 0; dim--) {
+        auto len = static_cast<size_t>(dims_[dim - 1]);
+        offset += (rest % len + 1) * strides_[dim - 1];
+        rest /= len;
+      }
+      tree_[offset] = values[flat];
+    }
+    // 沿每一维各做一遍一维的线性建树
+    for (size_t dim = 0; dim < D; dim++) {
+      auto len = static_cast<size_t>(dims_[dim]) + 1;
+      for (size_t offset = 0; offset < tree_.size(); offset++) {
+        size_t coord = offset / strides_[dim] % len;
+        if (coord == 0) {
+          continue;
+        }
+        size_t parent = coord + bitop::lowbit(coord);
+        if (parent < len) {
+          size_t target = offset + (parent - coord) * strides_[dim];
+          tree_[target] = group_.op(tree_[target], tree_[offset]);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] auto dims() const -> const Index & { return dims_; }
+
+  void apply(const Index &ind, T val) {
+    checkIndex(ind, 0, "FenwickTreeND::apply invalid index");
+    applyDim<0>(0, ind, val);
+  }
+  // 前缀 [0, ind] 的和，某一维为 -1 时结果为单位元
+  auto query(const Index &ind) const -> T {
+    checkIndex(ind, -1, "FenwickTreeND::query invalid index");
+    return prefixDim<0>(0, ind);
+  }
+  // 闭区间超矩形 [lo, hi]
+  auto query(const Index &lower, const Index &upper) const -> T {
+    for (size_t dim = 0; dim < D; dim++) {
+      if (lower[dim] < 0 || upper[dim] >= dims_[dim] ||
+          lower[dim] > upper[dim]) {
+        throw std::out_of_range("FenwickTreeND::query invalid box");
+      }
+    }
+    T result = group_.identity();
+    for (size_t mask = 0; mask < (size_t{1} << D); mask++) {
+      Index corner = upper;
+      bool negative = false;
+      for (size_t dim = 0; dim < D; dim++) {
+        if (((mask >> dim) & 1) != 0) {
+          corner[dim] = lower[dim] - 1;
+          negative = !negative;
+        }
+      }
+      T part = prefixDim<0>(0, corner);
+      result = negative ? group_.inv(result, part) : group_.op(result, part);
+    }
+    return result;
+  }
+
+  // 二维时的便捷接口
+  template <size_t DIM = D, std::enable_if_t<DIM == 2, int> = 0>
+  void apply(int64_t row, int64_t col, T val) {
+    apply(Index{row, col}, val);
+  }
+  template <size_t DIM = D, std::enable_if_t<DIM == 2, int> = 0>
+  auto query(int64_t row1, int64_t col1, int64_t row2, int64_t col2) const
+      -> T {
+    return query(Index{row1, col1}, Index{row2, col2});
+  }
+};
+
+template <typename Group>
+using FenwickTree2D = FenwickTreeND<Group, 2>;
+}  // namespace mystd::fenwick_tree
+
+#endif  // FENWICKTREEND_HPP
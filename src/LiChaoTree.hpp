@@ -0,0 +1,273 @@
+#ifndef LICHAOTREE_HPP
+#define LICHAOTREE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "BitOperation.hpp"
+#include "Compare.hpp"
+#include "Vector.hpp"
+
+namespace mystd::segment_tree {
+
+// 直线 y = a x + b
+template <typename T>
+struct Line {
+  T a, b;
+  auto eval(int64_t pos) const -> T { return a * static_cast<T>(pos) + b; }
+};
+
+/// INFO: 李超线段树，维护一组直线（或线段）在整数点上的最优值
+/// Compare 为 Less 时求最小值，为 Greater 时求最大值
+/// 每个节点保存一条在其区间中点上最优的直线，插入时与之比较中点的值，
+/// 较差的一条只可能在一侧更优，继续向那一侧下放：addLine 与 query 都是
+/// O(log C)，addSegment 先拆成 O(log C) 个节点，为 O(log^2 C)
+/// 初始时每个节点都是水平线 y = init，因此没有直线覆盖的点查询结果为 init
+/// 调用者需保证 a x + b 在 T 中不会溢出
+template <typename T, typename Compare = mystd::compare::Less<T>>
+class LiChaoTree {
+private:
+  int64_t lo_, hi_;
+  // 节点 ind 的子节点为 2 * ind 和 2 * ind + 1，2 * bitCeil(hi - lo) 个足够
+  std::vector<Line<T>> tree_;
+  Compare comp_;
+
+  // 节点管辖闭区间 [node_left, node_right]，均为实际坐标
+  void insert(int64_t ind, int64_t node_left, int64_t node_right,
+              Line<T> line) {
+    while (true) {
+      Line<T> &cur = tree_[ind];
+      int64_t mid = node_left + (node_right - node_left) / 2;
+      bool left_better = comp_(line.eval(node_left), cur.eval(node_left));
+      bool mid_better = comp_(line.eval(mid), cur.eval(mid));
+      if (mid_better) {
+        Line<T> tmp = cur;
+        cur = line;
+        line = tmp;
+      }
+      if (node_left == node_right) {
+        return;
+      }
+      // 交点在左半边时，换下来的直线只可能在左半边更优
+      if (left_better != mid_better) {
+        ind = ind * 2;
+        node_right = mid;
+      } else {
+        ind = ind * 2 + 1;
+        node_left = mid + 1;
+      }
+    }
+  }
+  void insertSegment(int64_t ind, int64_t node_left, int64_t node_right,
+                     int64_t left_bound, int64_t right_bound, Line<T> line) {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      insert(ind, node_left, node_right, line);
+      return;
+    }
+    int64_t mid = node_left + (node_right - node_left) / 2;
+    if (left_bound <= mid) {
+      insertSegment(ind * 2, node_left, mid, left_bound, right_bound, line);
+    }
+    if (mid < right_bound) {
+      insertSegment(ind * 2 + 1, mid + 1, node_right, left_bound, right_bound,
+                    line);
+    }
+  }
+
+public:
+  // 横坐标范围为 [lo, hi)
+  LiChaoTree(int64_t lo, int64_t hi, T init, const Compare &comp = Compare())
+      : lo_(lo), hi_(hi), comp_(comp) {
+    if (lo >= hi) {
+      throw std::invalid_argument("LiChaoTree requires lo < hi");
+    }
+    auto width = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    // 超过 2^62 时 bitCeil(width) * 2 会溢出，这样的范围请用 DynamicLiChaoTree
+    if (width > (uint64_t{1} << 62)) {
+      throw std::length_error("LiChaoTree range too wide");
+    }
+    tree_.assign(static_cast<size_t>(bitop::bitCeil(width)) * 2,
+                 Line<T>{T{}, init});
+  }
+
+  [[nodiscard]] auto lo() const -> int64_t { return lo_; }
+  [[nodiscard]] auto hi() const -> int64_t { return hi_; }
+
+  void addLine(Line<T> line) { insert(1, lo_, hi_ - 1, line); }
+  // 只在闭区间 [L, R] 上生效的线段
+  void addSegment(int64_t left_bound, int64_t right_bound, Line<T> line) {
+    if (left_bound < lo_ || right_bound >= hi_ || left_bound > right_bound) {
+      throw std::out_of_range("LiChaoTree::addSegment invalid interval");
+    }
+    insertSegment(1, lo_, hi_ - 1, left_bound, right_bound, line);
+  }
+  // 所有覆盖 pos 的直线在 pos 处的最优值
+  auto query(int64_t pos) const -> T {
+    if (pos < lo_ || pos >= hi_) {
+      throw std::out_of_range("LiChaoTree::query index out of range");
+    }
+    int64_t ind = 1;
+    int64_t node_left = lo_;
+    int64_t node_right = hi_ - 1;
+    T result = tree_[1].eval(pos);
+    while (node_left != node_right) {
+      int64_t mid = node_left + (node_right - node_left) / 2;
+      if (pos <= mid) {
+        ind = ind * 2;
+        node_right = mid;
+      } else {
+        ind = ind * 2 + 1;
+        node_left = mid + 1;
+      }
+      T val = tree_[ind].eval(pos);
+      result = comp_(val, result) ? val : result;
+    }
+    return result;
+  }
+};
+
+/// INFO: 动态开点的李超线段树，横坐标可以是任意的 int64_t 范围
+/// 与 DynamicSegmentTree 一样，节点存放在 mystd::Vector 中，用 32 位下标相连，
+/// 只为插入路径上的节点分配空间，每次 addLine 至多新建 O(log C) 个节点
+/// 语义与 LiChaoTree 相同；坐标差在 uint64_t 中计算，不会溢出
+template <typename T, typename Compare = mystd::compare::Less<T>>
+class DynamicLiChaoTree {
+private:
+  using Index = uint32_t;
+  // 0 号节点是哨兵，表示子节点尚未创建
+  static constexpr Index NIL = 0;
+
+  struct Node {
+    Line<T> line_;
+    Index left_ = NIL, right_ = NIL;
+    explicit Node(Line<T> line) : line_(line) {}
+  };
+
+  int64_t lo_, hi_;
+  T init_;
+  vector::Vector<Node> pool_;
+  Compare comp_;
+
+  auto newNode(Line<T> line) -> Index {
+    if (pool_.size() > UINT32_MAX) {
+      throw std::length_error("DynamicLiChaoTree node pool exhausted");
+    }
+    pool_.emplaceBack(line);
+    return static_cast<Index>(pool_.size() - 1);
+  }
+  static auto midPoint(int64_t left, int64_t right) -> int64_t {
+    auto span = static_cast<uint64_t>(right) - static_cast<uint64_t>(left);
+    return static_cast<int64_t>(static_cast<uint64_t>(left) + span / 2);
+  }
+  // 节点管辖闭区间 [node_left, node_right]；子节点不存在时直接放进新节点
+  void insert(Index ind, int64_t node_left, int64_t node_right,
+              Line<T> line) {
+    while (true) {
+      int64_t mid = midPoint(node_left, node_right);
+      Line<T> cur = pool_[ind].line_;
+      bool left_better = comp_(line.eval(node_left), cur.eval(node_left));
+      bool mid_better = comp_(line.eval(mid), cur.eval(mid));
+      if (mid_better) {
+        pool_[ind].line_ = line;
+        line = cur;
+      }
+      if (node_left == node_right) {
+        return;
+      }
+      bool go_left = left_better != mid_better;
+      Index child = go_left ? pool_[ind].left_ : pool_[ind].right_;
+      if (child == NIL) {
+        child = newNode(line);
+        if (go_left) {
+          pool_[ind].left_ = child;
+        } else {
+          pool_[ind].right_ = child;
+        }
+        return;
+      }
+      ind = child;
+      if (go_left) {
+        node_right = mid;
+      } else {
+        node_left = mid + 1;
+      }
+    }
+  }
+  void insertSegment(Index ind, int64_t node_left, int64_t node_right,
+                     int64_t left_bound, int64_t right_bound, Line<T> line) {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      insert(ind, node_left, node_right, line);
+      return;
+    }
+    int64_t mid = midPoint(node_left, node_right);
+    if (left_bound <= mid) {
+      if (pool_[ind].left_ == NIL) {
+        Index child = newNode(Line<T>{T{}, init_});
+        pool_[ind].left_ = child;
+      }
+      insertSegment(pool_[ind].left_, node_left, mid, left_bound, right_bound,
+                    line);
+    }
+    if (mid < right_bound) {
+      if (pool_[ind].right_ == NIL) {
+        Index child = newNode(Line<T>{T{}, init_});
+        pool_[ind].right_ = child;
+      }
+      insertSegment(pool_[ind].right_, mid + 1, node_right, left_bound,
+                    right_bound, line);
+    }
+  }
+
+public:
+  // 横坐标范围为 [lo, hi)
+  DynamicLiChaoTree(int64_t lo, int64_t hi, T init,
+                    const Compare &comp = Compare())
+      : lo_(lo), hi_(hi), init_(init), comp_(comp) {
+    if (lo >= hi) {
+      throw std::invalid_argument("DynamicLiChaoTree requires lo < hi");
+    }
+    pool_.emplaceBack(Line<T>{T{}, init});  // 哨兵
+    newNode(Line<T>{T{}, init});            // 根节点为 1 号
+  }
+
+  [[nodiscard]] auto lo() const -> int64_t { return lo_; }
+  [[nodiscard]] auto hi() const -> int64_t { return hi_; }
+  // 已创建的节点数（不含哨兵）
+  [[nodiscard]] auto nodeCount() const -> size_t { return pool_.size() - 1; }
+  void reserve(size_t nodes) { pool_.reserve(nodes + 1); }
+
+  void addLine(Line<T> line) { insert(1, lo_, hi_ - 1, line); }
+  // 只在闭区间 [L, R] 上生效的线段
+  void addSegment(int64_t left_bound, int64_t right_bound, Line<T> line) {
+    if (left_bound < lo_ || right_bound >= hi_ || left_bound > right_bound) {
+      throw std::out_of_range("DynamicLiChaoTree::addSegment invalid interval");
+    }
+    insertSegment(1, lo_, hi_ - 1, left_bound, right_bound, line);
+  }
+  auto query(int64_t pos) const -> T {
+    if (pos < lo_ || pos >= hi_) {
+      throw std::out_of_range("DynamicLiChaoTree::query index out of range");
+    }
+    Index ind = 1;
+    int64_t node_left = lo_;
+    int64_t node_right = hi_ - 1;
+    T result = init_;
+    while (ind != NIL) {
+      T val = pool_[ind].line_.eval(pos);
+      result = comp_(val, result) ? val : result;
+      int64_t mid = midPoint(node_left, node_right);
+      if (pos <= mid) {
+        ind = pool_[ind].left_;
+        node_right = mid;
+      } else {
+        ind = pool_[ind].right_;
+        node_left = mid + 1;
+      }
+    }
+    return result;
+  }
+};
+}  // namespace mystd::segment_tree
+
+#endif  // LICHAOTREE_HPP
@@ -0,0 +1,256 @@
+#ifndef LOSERTREE_HPP
+#define LOSERTREE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "BitOperation.hpp"
+#include "Compare.hpp"
+#include "Vector.hpp"
+#include "common.h"
+
+namespace mystd::loser_tree {
+
+namespace detail {
+/// INFO: 只保存叶子编号的败者树，叶子之间的比较由调用方以 beats 的形式给出
+/// beats(a, b) 为真表示叶子 a 应当先于叶子 b 输出；补齐出来的叶子永远落败
+class Tournament {
+private:
+  size_t leaf_count_ = 0;
+  size_t leaves_ = 1;
+  // tree_[0] 为冠军，tree_[1, leaves_) 为对应内部节点上的败者
+  vector::Vector<size_t> tree_;
+
+  template <typename Beats>
+  auto wins(size_t lhs, size_t rhs, Beats &beats) const -> bool {
+    if (lhs >= leaf_count_) {
+      return false;
+    }
+    if (rhs >= leaf_count_) {
+      return true;
+    }
+    return beats(lhs, rhs);
+  }
+
+public:
+  // 自底向上建树，共 leaves_ - 1 次比较
+  template <typename Beats>
+  void build(size_t leaf_count, Beats beats) {
+    leaf_count_ = leaf_count;
+    leaves_ = bitop::bitCeil(mystd::max<size_t>(leaf_count, 1));
+    tree_ = vector::Vector<size_t>(leaves_, 0);
+    vector::Vector<size_t> winner(leaves_ * 2, 0);
+    for (size_t i = 0; i < leaves_; i++) {
+      winner[leaves_ + i] = i;
+    }
+    for (size_t node = leaves_ - 1; node > 0; node--) {
+      size_t lhs = winner[node * 2];
+      size_t rhs = winner[node * 2 + 1];
+      if (wins(rhs, lhs, beats)) {
+        mystd::swap(lhs, rhs);
+      }
+      winner[node] = lhs;
+      tree_[node] = rhs;
+    }
+    tree_[0] = winner[1];
+  }
+
+  // 冠军叶子的值发生变化后，沿它到根的路径重赛，恰好 log k 次比较
+  template <typename Beats>
+  void replay(Beats beats) {
+    size_t winner = tree_[0];
+    for (size_t node = (winner + leaves_) >> 1; node > 0; node >>= 1) {
+      if (wins(tree_[node], winner, beats)) {
+        mystd::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+  [[nodiscard]] auto winner() const -> size_t { return tree_[0]; }
+  [[nodiscard]] auto leafCount() const -> size_t { return leaf_count_; }
+};
+}  // namespace detail
+
+/// INFO: 基于值的败者树，每个槽位保存一个当前候选
+/// 适合外部排序中由调用方管理缓冲区的场景
+/// 默认按 Less 升序输出；相等时槽位编号小的先输出
+template <typename T, typename Compare = mystd::compare::Less<T>>
+class LoserTree {
+private:
+  vector::Vector<T> values_;
+  vector::Vector<bool> retired_;
+  size_t alive_;
+  Compare comp_;
+  detail::Tournament tournament_;
+
+  auto beats() {
+    return [this](size_t lhs, size_t rhs) -> bool {
+      if (retired_[lhs]) {
+        return false;
+      }
+      if (retired_[rhs]) {
+        return true;
+      }
+      return lhs < rhs ? !comp_(values_[rhs], values_[lhs])
+                       : comp_(values_[lhs], values_[rhs]);
+    };
+  }
+
+public:
+  explicit LoserTree(vector::Vector<T> init, const Compare &comp = Compare())
+      : values_(std::move(init)),
+        retired_(values_.size(), false),
+        alive_(values_.size()),
+        comp_(comp) {
+    tournament_.build(values_.size(), beats());
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return alive_ == 0; }
+  [[nodiscard]] auto size() const -> size_t { return alive_; }
+
+  auto top() const -> const T & {
+    if (empty()) {
+      throw std::out_of_range("LoserTree::top on empty tree");
+    }
+    return values_[tournament_.winner()];
+  }
+  // 当前冠军所在的槽位编号
+  [[nodiscard]] auto topIndex() const -> size_t {
+    if (empty()) {
+      throw std::out_of_range("LoserTree::topIndex on empty tree");
+    }
+    return tournament_.winner();
+  }
+
+  // 用同一槽位的下一个值替换冠军，只重赛一条路径
+  template <typename U>
+  void replaceTop(U &&value) {
+    if (empty()) {
+      throw std::out_of_range("LoserTree::replaceTop on empty tree");
+    }
+    values_[tournament_.winner()] = std::forward<U>(value);
+    tournament_.replay(beats());
+  }
+
+  // 冠军所在槽位已耗尽
+  void retireTop() {
+    if (empty()) {
+      throw std::out_of_range("LoserTree::retireTop on empty tree");
+    }
+    retired_[tournament_.winner()] = true;
+    alive_--;
+    tournament_.replay(beats());
+  }
+};
+
+/// INFO: 对 k 个有序区间做惰性的 k 路归并，每输出一个元素只需 log k 次比较
+/// 不复制元素，迭代器解引用得到的是原区间中元素的引用
+template <typename Iter,
+          typename Compare = mystd::compare::Less<
+              typename std::iterator_traits<Iter>::value_type>>
+class KWayMerger {
+public:
+  using ValueType = typename std::iterator_traits<Iter>::value_type;
+  using Reference = typename std::iterator_traits<Iter>::reference;
+  using Range = std::pair<Iter, Iter>;
+
+private:
+  vector::Vector<Range> runs_;
+  Compare comp_;
+  detail::Tournament tournament_;
+
+  auto beats() {
+    return [this](size_t lhs, size_t rhs) -> bool {
+      const Range &lrun = runs_[lhs];
+      const Range &rrun = runs_[rhs];
+      if (lrun.first == lrun.second) {
+        return false;
+      }
+      if (rrun.first == rrun.second) {
+        return true;
+      }
+      return lhs < rhs ? !comp_(*rrun.first, *lrun.first)
+                       : comp_(*lrun.first, *rrun.first);
+    };
+  }
+
+public:
+  class Iterator {
+    friend class KWayMerger;
+
+  private:
+    KWayMerger *merger_;
+
+    explicit Iterator(KWayMerger *merger) : merger_(merger) {}
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Reference;
+
+    auto operator*() const -> Reference { return merger_->top(); }
+    auto operator++() -> Iterator & {
+      merger_->pop();
+      return *this;
+    }  // 前置++
+
+    // 所有输入迭代器共享同一个归并状态，只需区分是否已经结束
+    auto operator==(const Iterator &other) const -> bool {
+      bool lhs_end = merger_ == nullptr || merger_->empty();
+      bool rhs_end = other.merger_ == nullptr || other.merger_->empty();
+      return lhs_end == rhs_end;
+    }
+    auto operator!=(const Iterator &other) const -> bool {
+      return !(*this == other);
+    }
+  };
+
+  explicit KWayMerger(vector::Vector<Range> runs,
+                      const Compare &comp = Compare())
+      : runs_(std::move(runs)), comp_(comp) {
+    tournament_.build(runs_.size(), beats());
+  }
+
+  [[nodiscard]] auto empty() const -> bool {
+    if (runs_.empty()) {
+      return true;
+    }
+    const Range &run = runs_[tournament_.winner()];
+    return run.first == run.second;
+  }
+
+  auto top() const -> Reference {
+    if (empty()) {
+      throw std::out_of_range("KWayMerger::top on exhausted merger");
+    }
+    return *runs_[tournament_.winner()].first;
+  }
+  // 当前元素来自第几个输入区间
+  [[nodiscard]] auto topRun() const -> size_t {
+    if (empty()) {
+      throw std::out_of_range("KWayMerger::topRun on exhausted merger");
+    }
+    return tournament_.winner();
+  }
+
+  // 替换冠军：推进冠军所在区间后只重赛一条路径
+  void pop() {
+    if (empty()) {
+      throw std::out_of_range("KWayMerger::pop on exhausted merger");
+    }
+    ++runs_[tournament_.winner()].first;
+    tournament_.replay(beats());
+  }
+
+  auto begin() -> Iterator { return Iterator(this); }
+  auto end() -> Iterator { return Iterator(nullptr); }
+};
+
+}  // namespace mystd::loser_tree
+
+#endif  // LOSERTREE_HPP
@@ -0,0 +1,145 @@
+#ifndef MULTIQUEUE_HPP
+#define MULTIQUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "BinaryHeap.hpp"
+#include "Compare.hpp"
+#include "Vector.hpp"
+
+namespace mystd::multi_queue {
+
+/// INFO: 线程安全的松弛优先队列（MultiQueue），默认大根堆
+/// 由 c·P 个各自带锁的 BinaryHeap 分片组成：push 放入随机分片，pop 从随机选出的
+/// 若干分片中取堆顶最优的一个。出队顺序只是近似有序，分片越多、采样越少则越松弛
+template <typename T, typename Compare = mystd::compare::Less<T>>
+class MultiQueue {
+private:
+  struct Shard {
+    std::mutex mutex_;
+    binary_heap::BinaryHeap<T, Compare> heap_;
+  };
+
+  // 随机选分片失败（抢锁失败或分片为空）多少次后退化为逐个扫描
+  static constexpr size_t MAX_ATTEMPTS = 16;
+  static constexpr size_t MAX_CHOICES = 8;
+
+  vector::Vector<Shard> shards_;
+  size_t choices_;
+  Compare comp_;
+  std::atomic<size_t> size_{0};
+
+  // 每个线程独立的 xorshift 随机数，避免共享随机数引擎成为新的竞争点
+  static auto nextRandom() -> uint64_t {
+    thread_local uint64_t state =
+        0x9E3779B97F4A7C15ULL ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+  auto randomShard() -> size_t { return nextRandom() % shards_.size(); }
+
+  // 已经持有 shard 的锁，并且堆非空
+  void popLocked(Shard &shard, T &out) {
+    out = shard.heap_.top();
+    shard.heap_.pop();
+    size_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+public:
+  // threads: 预计的并发线程数；factor: 每个线程对应的分片数 c；
+  // choices: pop 时采样的分片数（不超过 8），越大越接近严格优先队列
+  explicit MultiQueue(size_t threads, size_t factor = 2, size_t choices = 2,
+                      const Compare &comp = Compare())
+      : shards_(mystd::max<size_t>(threads * factor, 1)),
+        choices_(mystd::min(mystd::max<size_t>(choices, 1), MAX_CHOICES)),
+        comp_(comp) {
+    if (threads == 0 || factor == 0) {
+      throw std::invalid_argument("MultiQueue requires threads, factor > 0");
+    }
+  }
+
+  [[nodiscard]] auto shardCount() const -> size_t { return shards_.size(); }
+  // 并发修改时只是近似值
+  [[nodiscard]] auto size() const -> size_t {
+    return size_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+  template <typename U>
+  void push(U &&value) {
+    for (size_t attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+      Shard &shard = shards_[randomShard()];
+      std::unique_lock<std::mutex> lock(shard.mutex_, std::try_to_lock);
+      if (lock.owns_lock()) {
+        shard.heap_.push(std::forward<U>(value));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    Shard &shard = shards_[randomShard()];
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.heap_.push(std::forward<U>(value));
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // 取出一个近似最优的元素；返回 false 表示所有分片都为空
+  auto tryPop(T &out) -> bool {
+    for (size_t attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+      if (empty()) {
+        return false;
+      }
+      // 同时持有被采样分片的锁再比较堆顶，只用 try_lock 所以不会死锁
+      Shard *best = nullptr;
+      std::array<std::unique_lock<std::mutex>, MAX_CHOICES> locks;
+      size_t held = 0;
+      bool all_locked = true;
+      for (size_t i = 0; i < choices_; i++) {
+        Shard &shard = shards_[randomShard()];
+        bool duplicate = false;
+        for (size_t j = 0; j < held; j++) {
+          duplicate = duplicate || locks[j].mutex() == &shard.mutex_;
+        }
+        if (duplicate) {
+          continue;
+        }
+        locks[held] = std::unique_lock<std::mutex>(shard.mutex_,
+                                                   std::try_to_lock);
+        if (!locks[held++].owns_lock()) {
+          all_locked = false;
+          break;
+        }
+        if (!shard.heap_.empty() &&
+            (best == nullptr ||
+             comp_(best->heap_.top(), shard.heap_.top()))) {
+          best = &shard;
+        }
+      }
+      if (all_locked && best != nullptr) {
+        popLocked(*best, out);
+        return true;
+      }
+    }
+    // 采样一直失败时逐个扫描，保证非空时一定能取到元素
+    for (size_t i = 0; i < shards_.size(); i++) {
+      Shard &shard = shards_[i];
+      std::lock_guard<std::mutex> lock(shard.mutex_);
+      if (!shard.heap_.empty()) {
+        popLocked(shard, out);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+}  // namespace mystd::multi_queue
+
+#endif  // MULTIQUEUE_HPP
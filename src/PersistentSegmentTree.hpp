@@ -0,0 +1,246 @@
+#ifndef PERSISTENTSEGMENTTREE_HPP
+#define PERSISTENTSEGMENTTREE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Vector.hpp"
+
+namespace mystd::segment_tree {
+
+/// INFO: 可持久化（多版本）懒标记线段树，每次修改复制 O(log n) 个节点，
+/// 返回新的版本号，未修改的节点在版本之间共享
+/// 修改时沿路径下传标记，被下传到的兄弟节点也要复制，每层至多新建 4 个节点；
+/// 查询不下传，而是自底向上逐层套用节点上的标记
+/// 所有节点存放在一个 mystd::Vector 实现的 arena 中，节点之间用 32 位下标相连：
+/// rollback 直接截断 arena，dropBefore 把仍可达的节点整体搬到新的 arena 中
+/// 要求 mapping(f, op(a, b)) == op(mapping(f, a), mapping(f, b))
+template <typename T, T (*op)(T, T), T (*e)(), typename F, T (*mapping)(F, T),
+          F (*composition)(F, F), F (*id)()>
+class PersistentSegmentTree {
+private:
+  using Index = uint32_t;
+  // 0 号节点是哨兵，叶子的子节点和已丢弃版本的根都是 NIL
+  static constexpr Index NIL = 0;
+
+  struct Node {
+    T value_;
+    F lazy_;
+    Index left_, right_;
+    Node(T value, F lazy, Index left, Index right)
+        : value_(value), lazy_(lazy), left_(left), right_(right) {}
+  };
+
+  int64_t arr_size_;
+  vector::Vector<Node> pool_;
+  // roots_[v] 为版本 v 的根；version_end_[v] 为创建版本 v 之后 arena 的大小
+  std::vector<Index> roots_;
+  std::vector<size_t> version_end_;
+  int first_version_ = 0;
+
+  auto newNode(T value, F lazy, Index left, Index right) -> Index {
+    if (pool_.size() > UINT32_MAX) {
+      throw std::length_error("PersistentSegmentTree node pool exhausted");
+    }
+    pool_.emplaceBack(value, lazy, left, right);
+    return static_cast<Index>(pool_.size() - 1);
+  }
+  // 复制节点并把 func 作用在整棵子树上
+  auto copyWith(Index ind, F func) -> Index {
+    Node cur = pool_[ind];
+    return newNode(mapping(func, cur.value_), composition(func, cur.lazy_),
+                   cur.left_, cur.right_);
+  }
+
+  // 节点管辖半开区间 [node_left, node_right)
+  auto build(const std::vector<T> &arr, int64_t node_left, int64_t node_right)
+      -> Index {
+    if (node_right - node_left == 1) {
+      return newNode(arr[node_left], id(), NIL, NIL);
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    Index left = build(arr, node_left, mid);
+    Index right = build(arr, mid, node_right);
+    return newNode(op(pool_[left].value_, pool_[right].value_), id(), left,
+                   right);
+  }
+  // 复制节点并依次把 tag、func 作用在整棵子树上
+  auto copyWith(Index ind, F tag, F func) -> Index {
+    return copyWith(ind, composition(func, tag));
+  }
+  // tag 为父节点下传过来、尚未作用到本子树上的标记
+  auto applyRange(Index ind, int64_t node_left, int64_t node_right,
+                  int64_t left_bound, int64_t right_bound, F tag, F func)
+      -> Index {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      return copyWith(ind, tag, func);
+    }
+    Node cur = pool_[ind];
+    F pushed = composition(tag, cur.lazy_);
+    int64_t mid = (node_left + node_right) / 2;
+    Index left = left_bound < mid
+                     ? applyRange(cur.left_, node_left, mid, left_bound,
+                                  right_bound, pushed, func)
+                     : copyWith(cur.left_, pushed);
+    Index right = mid < right_bound
+                      ? applyRange(cur.right_, mid, node_right, left_bound,
+                                   right_bound, pushed, func)
+                      : copyWith(cur.right_, pushed);
+    return newNode(op(pool_[left].value_, pool_[right].value_), id(), left,
+                   right);
+  }
+  // tag 为父节点下传过来、尚未作用到本子树上的标记
+  auto assignPoint(Index ind, int64_t node_left, int64_t node_right,
+                   int64_t pos, T val, F tag) -> Index {
+    if (node_right - node_left == 1) {
+      return newNode(val, id(), NIL, NIL);
+    }
+    Node cur = pool_[ind];
+    F pushed = composition(tag, cur.lazy_);
+    int64_t mid = (node_left + node_right) / 2;
+    Index left = 0;
+    Index right = 0;
+    if (pos < mid) {
+      left = assignPoint(cur.left_, node_left, mid, pos, val, pushed);
+      right = copyWith(cur.right_, pushed);
+    } else {
+      left = copyWith(cur.left_, pushed);
+      right = assignPoint(cur.right_, mid, node_right, pos, val, pushed);
+    }
+    return newNode(op(pool_[left].value_, pool_[right].value_), id(), left,
+                   right);
+  }
+  auto queryRange(Index ind, int64_t node_left, int64_t node_right,
+                  int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      return pool_[ind].value_;
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    T result = e();
+    if (left_bound < mid) {
+      result = queryRange(pool_[ind].left_, node_left, mid, left_bound,
+                          right_bound);
+    }
+    if (mid < right_bound) {
+      result = op(result, queryRange(pool_[ind].right_, mid, node_right,
+                                     left_bound, right_bound));
+    }
+    // 节点上的标记作用在整棵子树上，自然也作用在其中的一部分上
+    return mapping(pool_[ind].lazy_, result);
+  }
+  // 后序复制到新的 arena，remap 记录旧下标到新下标的映射
+  auto relocate(Index ind, vector::Vector<Node> &target,
+                std::vector<Index> &remap) const -> Index {
+    if (ind == NIL || remap[ind] != NIL) {
+      return remap[ind];
+    }
+    Index left = relocate(pool_[ind].left_, target, remap);
+    Index right = relocate(pool_[ind].right_, target, remap);
+    target.emplaceBack(pool_[ind].value_, pool_[ind].lazy_, left, right);
+    remap[ind] = static_cast<Index>(target.size() - 1);
+    return remap[ind];
+  }
+  auto root(int version, const char *msg) const -> Index {
+    if (version < first_version_ || version >= versionCount()) {
+      throw std::out_of_range(msg);
+    }
+    return roots_[version];
+  }
+  auto pushVersion(Index new_root) -> int {
+    roots_.push_back(new_root);
+    version_end_.push_back(pool_.size());
+    return versionCount() - 1;
+  }
+
+public:
+  explicit PersistentSegmentTree(int64_t arr_size)
+      : PersistentSegmentTree(std::vector<T>(arr_size, e())) {}
+  // 数组下标从 0 开始，初始数组为版本 0
+  explicit PersistentSegmentTree(const std::vector<T> &arr)
+      : arr_size_(static_cast<int64_t>(arr.size())) {
+    if (arr.empty()) {
+      throw std::invalid_argument("PersistentSegmentTree requires n > 0");
+    }
+    pool_.reserve(2 * arr.size());
+    pool_.emplaceBack(e(), id(), NIL, NIL);  // 哨兵
+    pushVersion(build(arr, 0, arr_size_));
+  }
+
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  // 已创建的版本总数，包括已经丢弃的旧版本
+  [[nodiscard]] auto versionCount() const -> int {
+    return static_cast<int>(roots_.size());
+  }
+  // 最早的仍可查询的版本
+  [[nodiscard]] auto firstVersion() const -> int { return first_version_; }
+  // arena 中的节点数（不含哨兵）
+  [[nodiscard]] auto nodeCount() const -> size_t { return pool_.size() - 1; }
+
+  // 在版本 version 的基础上修改，返回新版本号
+  auto assign(int version, int64_t ind, T val) -> int {
+    Index base = root(version, "PersistentSegmentTree::assign invalid version");
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("PersistentSegmentTree::assign invalid index");
+    }
+    return pushVersion(assignPoint(base, 0, arr_size_, ind, val, id()));
+  }
+  auto apply(int version, int64_t ind, F func) -> int {
+    return apply(version, ind, ind, func);
+  }
+  // 区间为闭区间 [L, R]
+  auto apply(int version, int64_t left_bound, int64_t right_bound, F func)
+      -> int {
+    Index base = root(version, "PersistentSegmentTree::apply invalid version");
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("PersistentSegmentTree::apply invalid interval");
+    }
+    return pushVersion(
+        applyRange(base, 0, arr_size_, left_bound, right_bound + 1, id(),
+                   func));
+  }
+
+  auto query(int version, int64_t ind) const -> T {
+    return query(version, ind, ind);
+  }
+  // 区间为闭区间 [L, R]
+  auto query(int version, int64_t left_bound, int64_t right_bound) const -> T {
+    Index base = root(version, "PersistentSegmentTree::query invalid version");
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("PersistentSegmentTree::query invalid interval");
+    }
+    return queryRange(base, 0, arr_size_, left_bound, right_bound + 1);
+  }
+
+  // 丢弃 version 之后的所有版本，arena 直接截断到创建 version 时的大小
+  void rollback(int version) {
+    root(version, "PersistentSegmentTree::rollback invalid version");
+    roots_.resize(version + 1);
+    version_end_.resize(version + 1);
+    while (pool_.size() > version_end_[version]) {
+      pool_.popBack();
+    }
+  }
+  // 丢弃 version 之前的所有版本，O(节点数) 地把仍可达的节点搬到新的 arena；
+  // 版本号保持不变
+  void dropBefore(int version) {
+    root(version, "PersistentSegmentTree::dropBefore invalid version");
+    vector::Vector<Node> target;
+    target.reserve(pool_.size());
+    target.emplaceBack(e(), id(), NIL, NIL);
+    std::vector<Index> remap(pool_.size(), NIL);
+    // 按版本顺序搬运，仍保证每个版本新建的节点都在之前版本的节点之后
+    for (int v = first_version_; v < versionCount(); v++) {
+      roots_[v] = v < version ? NIL : relocate(roots_[v], target, remap);
+      version_end_[v] = target.size();
+    }
+    first_version_ = version;
+    target.shrinkToFit();
+    pool_.swap(target);
+  }
+};
+}  // namespace mystd::segment_tree
+
+#endif  // PERSISTENTSEGMENTTREE_HPP
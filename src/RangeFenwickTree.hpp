@@ -0,0 +1,113 @@
+#ifndef RANGEFENWICKTREE_HPP
+#define RANGEFENWICKTREE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "FenwickTree.hpp"
+
+namespace mystd::fenwick_tree {
+
+/// INFO: 区间修改、区间查询的树状数组（两个树状数组维护差分）
+/// 设差分 d_i = a_i - a_{i-1}，则 sum(a_0..a_p) = (p + 1) * sum(d_0..d_p) -
+/// sum(d_i * i)，两部分各用一个 BasicFenwickTree 维护
+/// 要求 Group 满足交换律；n 个元素做 op 由 group::times 给出
+template <typename Group>
+class RangeFenwickTree {
+public:
+  using ValueType = typename Group::ValueType;
+
+private:
+  using T = ValueType;
+  int64_t arr_size_;
+  BasicFenwickTree<Group> diff_;      // d_i
+  BasicFenwickTree<Group> weighted_;  // d_i * i
+  Group group_;
+
+  static auto buildDiff(const std::vector<T> &arr, const Group &grp)
+      -> std::vector<T> {
+    std::vector<T> diff(arr.size(), grp.identity());
+    for (size_t i = 0; i < arr.size(); i++) {
+      diff[i] = i == 0 ? arr[0] : grp.inv(arr[i], arr[i - 1]);
+    }
+    return diff;
+  }
+  static auto buildWeighted(std::vector<T> diff, const Group &grp)
+      -> std::vector<T> {
+    for (size_t i = 0; i < diff.size(); i++) {
+      diff[i] = group::times(grp, diff[i], i);
+    }
+    return diff;
+  }
+
+  // 前缀 [0, ind] 的和，ind 可以为 -1
+  auto prefix(int64_t ind) const -> T {
+    if (ind < 0) {
+      return group_.identity();
+    }
+    return group_.inv(
+        group::times(group_, diff_.query(ind), static_cast<uint64_t>(ind) + 1),
+        weighted_.query(ind));
+  }
+
+  void applyDiff(int64_t ind, T val) {
+    diff_.apply(ind, val);
+    weighted_.apply(ind,
+                    group::times(group_, val, static_cast<uint64_t>(ind)));
+  }
+
+public:
+  // 全为单位元时差分也全为单位元，直接建两棵空树
+  explicit RangeFenwickTree(int64_t arr_size, const Group &group = Group())
+      : arr_size_(arr_size),
+        diff_(arr_size, group),
+        weighted_(arr_size, group),
+        group_(group) {}
+  // 数组下标从 0 开始
+  explicit RangeFenwickTree(const std::vector<T> &arr,
+                            const Group &group = Group())
+      : arr_size_(static_cast<int64_t>(arr.size())),
+        diff_(buildDiff(arr, group), group),
+        weighted_(buildWeighted(buildDiff(arr, group), group), group),
+        group_(group) {}
+
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+
+  void apply(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("RangeFenwickTree::apply invalid index");
+    }
+    apply(ind, ind, val);
+  }
+  // 区间为闭区间 [L, R]，区间内每个元素都与 val 做 op
+  void apply(int64_t left_bound, int64_t right_bound, T val) {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("RangeFenwickTree::apply invalid interval");
+    }
+    applyDiff(left_bound, val);
+    if (right_bound + 1 < arr_size_) {
+      applyDiff(right_bound + 1, group::negate(group_, val));
+    }
+  }
+
+  // 单点的值就是差分的前缀和
+  auto query(int64_t ind) const -> T {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("RangeFenwickTree::query invalid index");
+    }
+    return diff_.query(ind);
+  }
+  // 区间为闭区间 [L, R]
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("RangeFenwickTree::query invalid interval");
+    }
+    return group_.inv(prefix(right_bound), prefix(left_bound - 1));
+  }
+};
+}  // namespace mystd::fenwick_tree
+
+#endif  // RANGEFENWICKTREE_HPP
@@ -1,7 +1,11 @@
 #ifndef SEGMENTTREE_HPP
 #define SEGMENTTREE_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "BitOperation.hpp"
@@ -12,41 +16,172 @@ template <typename T, T (*op)(T, T), T (*e)(), typename F, T (*mapping)(F, T),
           F (*composition)(F, F), F (*id)()>
 class SegmentTree {
 private:
-  int arr_size_, tree_size_, height_log_;
+  int64_t arr_size_, tree_size_;
+  int height_log_;
   // 为了方便在算法竞赛环境中使用，使用 std::vector 而不是 mystd::Vector
   std::vector<T> tree_;
   std::vector<F> lazy_;
-  void pushUp(int ind) { tree_[ind] = op(tree_[ind * 2], tree_[ind * 2 + 1]); }
-  void applyNode(int ind, F func) {
+  void pushUp(int64_t ind) {
+    tree_[ind] = op(tree_[ind * 2], tree_[ind * 2 + 1]);
+  }
+  void applyNode(int64_t ind, F func) {
     tree_[ind] = mapping(func, tree_[ind]);
     if (ind < tree_size_) {
       lazy_[ind] = composition(func, lazy_[ind]);
     }
   }
-  void pushDown(int ind) {
+  void pushDown(int64_t ind) {
     applyNode(ind * 2, lazy_[ind]);
     applyNode(ind * 2 + 1, lazy_[ind]);
     lazy_[ind] = id();
   }
+  // 节点 ind 管辖 [node_left, node_right)，pending 为其所有祖先上标记的复合
+  // 标记只在递归参数中向下传递，不写回树中
+  auto queryConst(int64_t ind, int64_t node_left, int64_t node_right,
+                  int64_t left_bound, int64_t right_bound, F pending) const
+      -> T {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      return mapping(pending, tree_[ind]);
+    }
+    F child_pending = composition(pending, lazy_[ind]);
+    int64_t mid = (node_left + node_right) / 2;
+    if (right_bound <= mid) {
+      return queryConst(ind * 2, node_left, mid, left_bound, right_bound,
+                        child_pending);
+    }
+    if (mid <= left_bound) {
+      return queryConst(ind * 2 + 1, mid, node_right, left_bound,
+                        right_bound, child_pending);
+    }
+    return op(queryConst(ind * 2, node_left, mid, left_bound, right_bound,
+                         child_pending),
+              queryConst(ind * 2 + 1, mid, node_right, left_bound,
+                         right_bound, child_pending));
+  }
+  // 建出深度为 depth 的节点 [first, last) 为根的子树：填入叶子后逐层 pushUp
+  void buildSubtrees(const std::vector<T> &arr, int64_t first, int64_t last,
+                     int depth) {
+    int below = height_log_ - depth;
+    for (int64_t i = first << below; i < (last << below); i++) {
+      if (i - tree_size_ < arr_size_) {
+        tree_[i] = arr[i - tree_size_];
+      }
+    }
+    for (int level = below - 1; level >= 0; level--) {
+      for (int64_t i = first << level; i < (last << level); i++) {
+        pushUp(i);
+      }
+    }
+  }
+  // 批量单点修改的公共部分：每个受影响的祖先只 pushDown、pushUp 各一次
+  template <typename U, typename Update>
+  void batchUpdate(std::vector<std::pair<int64_t, U>> updates,
+                   const char *msg, Update update) {
+    for (const auto &item : updates) {
+      if (item.first < 0 || item.first >= arr_size_) {
+        throw std::out_of_range(msg);
+      }
+    }
+    // 稳定排序，同一下标上的修改保持给出的顺序
+    std::stable_sort(
+        updates.begin(), updates.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    std::vector<int64_t> leaves;
+    leaves.reserve(updates.size());
+    for (const auto &item : updates) {
+      if (leaves.empty() || leaves.back() != item.first + tree_size_) {
+        leaves.push_back(item.first + tree_size_);
+      }
+    }
+    // 叶子有序，因此同一层的祖先也有序，相邻去重即可
+    for (int i = height_log_; i >= 1; i--) {
+      int64_t last = 0;
+      for (int64_t leaf : leaves) {
+        if ((leaf >> i) != last) {
+          last = leaf >> i;
+          pushDown(last);
+        }
+      }
+    }
+    for (const auto &item : updates) {
+      update(item.first + tree_size_, item.second);
+    }
+    for (int i = 1; i <= height_log_; i++) {
+      int64_t last = 0;
+      for (int64_t leaf : leaves) {
+        if ((leaf >> i) != last) {
+          last = leaf >> i;
+          pushUp(last);
+        }
+      }
+    }
+  }
 
 public:
-  explicit SegmentTree(int arr_size)
-      : SegmentTree(std::vector<T>(arr_size, e())) {}
+  // 所有叶子都是 e() 时内部节点也都是 e()，直接填充，不必逐个 pushUp
+  explicit SegmentTree(int64_t arr_size)
+      : arr_size_(arr_size),
+        tree_size_(static_cast<int64_t>(bitop::bitCeil(arr_size_))),
+        height_log_(static_cast<int>(bitop::countrZero(tree_size_))) {
+    if (arr_size < 0) {
+      throw std::invalid_argument("SegmentTree requires n >= 0");
+    }
+    tree_.resize(static_cast<size_t>(tree_size_) * 2, e());
+    lazy_.resize(tree_size_, id());
+  }
   // 数组下标从 0 开始
-  explicit SegmentTree(const std::vector<T> &arr)
-      : arr_size_(static_cast<int>(arr.size())),
-        tree_size_(bitop::bitCeil(arr_size_)),
-        height_log_(bitop::countrZero(tree_size_)) {
-    tree_.resize(tree_size_ * 2, e());
+  explicit SegmentTree(const std::vector<T> &arr) : SegmentTree(arr, 1) {}
+  // 多线程建树：取节点数不少于 threads 的最浅一层，把这一层以下的子树
+  // 分成 threads 份并行建出，再串行 pushUp 上面的几层
+  SegmentTree(const std::vector<T> &arr, unsigned threads)
+      : arr_size_(static_cast<int64_t>(arr.size())),
+        tree_size_(static_cast<int64_t>(bitop::bitCeil(arr_size_))),
+        height_log_(static_cast<int>(bitop::countrZero(tree_size_))) {
+    tree_.resize(static_cast<size_t>(tree_size_) * 2, e());
     lazy_.resize(tree_size_, id());
-    for (int i = 0; i < arr_size_; i++) {
-      tree_[tree_size_ + i] = arr[i];
+    int64_t workers = threads == 0 ? 1 : threads;
+    int depth = 0;
+    while ((int64_t{1} << depth) < workers && depth < height_log_) {
+      depth++;
     }
-    for (int i = tree_size_ - 1; i > 0; i--) {
+    int64_t roots = int64_t{1} << depth;
+    if (workers == 1) {
+      buildSubtrees(arr, roots, roots * 2, depth);
+    } else {
+      std::vector<std::thread> pool;
+      for (int64_t t = 0; t < workers; t++) {
+        int64_t first = roots + roots * t / workers;
+        int64_t last = roots + roots * (t + 1) / workers;
+        if (first < last) {
+          pool.emplace_back([this, &arr, first, last, depth]() {
+            buildSubtrees(arr, first, last, depth);
+          });
+        }
+      }
+      for (auto &worker : pool) {
+        worker.join();
+      }
+    }
+    for (int64_t i = roots - 1; i > 0; i--) {
       pushUp(i);
     }
   }
-  void assign(int ind, T val) {
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  // 批量单点修改，按下标排序后一起下传、上推；同一下标按给出的顺序依次作用
+  void applyBatch(std::vector<std::pair<int64_t, F>> updates) {
+    batchUpdate(std::move(updates),
+                "SegmentTree::applyBatch index out of range",
+                [this](int64_t leaf, const F &func) {
+                  tree_[leaf] = mapping(func, tree_[leaf]);
+                });
+  }
+  // 批量单点赋值，同一下标出现多次时以最后一次为准
+  void assignBatch(std::vector<std::pair<int64_t, T>> updates) {
+    batchUpdate(std::move(updates),
+                "SegmentTree::assignBatch index out of range",
+                [this](int64_t leaf, const T &val) { tree_[leaf] = val; });
+  }
+  void assign(int64_t ind, T val) {
     if (ind < 0 || ind >= arr_size_) {
       throw std::out_of_range("SegmentTree::assign index out of range");
     }
@@ -59,7 +194,37 @@ public:
       pushUp(ind >> i);
     }
   }
-  void apply(int ind, F func) {
+  // 用 values 覆盖 [l, l + values.size())，O(k + log n)：
+  // 只对左右边界上部分相交的祖先 pushDown，被完全覆盖的节点上的标记直接丢弃，
+  // 再逐层只重算覆盖区间所在的那一段节点
+  void assignRange(int64_t left_bound, const std::vector<T> &values) {
+    auto count = static_cast<int64_t>(values.size());
+    if (left_bound < 0 || left_bound > arr_size_ ||
+        count > arr_size_ - left_bound) {
+      throw std::out_of_range("SegmentTree::assignRange invalid interval");
+    }
+    if (count == 0) {
+      return;
+    }
+    left_bound += tree_size_;
+    int64_t right_bound = left_bound + count;
+    for (int i = height_log_; i >= 1; i--) {
+      if (((left_bound >> i) << i) != left_bound) {
+        pushDown(left_bound >> i);
+      }
+      if (((right_bound >> i) << i) != right_bound) {
+        pushDown((right_bound - 1) >> i);
+      }
+    }
+    std::copy(values.begin(), values.end(), tree_.begin() + left_bound);
+    for (int i = 1; i <= height_log_; i++) {
+      for (int64_t j = left_bound >> i; j <= (right_bound - 1) >> i; j++) {
+        lazy_[j] = id();
+        pushUp(j);
+      }
+    }
+  }
+  void apply(int64_t ind, F func) {
     if (ind < 0 || ind >= arr_size_) {
       throw std::out_of_range("SegmentTree::apply index out of range");
     }
@@ -73,7 +238,7 @@ public:
     }
   }
   // 区间为闭区间 [L, R]，但内部实现的时候使用半开区间 [L, R+1)
-  void apply(int left_bound, int right_bound, F func) {
+  void apply(int64_t left_bound, int64_t right_bound, F func) {
     if (left_bound < 0 || right_bound >= arr_size_ ||
         left_bound > right_bound) {
       throw std::out_of_range("SegmentTree::apply invalid interval");
@@ -88,8 +253,8 @@ public:
         pushDown((right_bound - 1) >> i);
       }
     }
-    int orig_left = left_bound;
-    int orig_right = right_bound;
+    int64_t orig_left = left_bound;
+    int64_t orig_right = right_bound;
     while (left_bound < right_bound) {
       if ((left_bound & 1) != 0) {
         applyNode(left_bound++, func);
@@ -109,7 +274,7 @@ public:
       }
     }
   }
-  auto query(int ind) -> T {
+  auto query(int64_t ind) -> T {
     if (ind < 0 || ind >= arr_size_) {
       throw std::out_of_range("SegmentTree::query index out of range");
     }
@@ -119,8 +284,29 @@ public:
     }
     return tree_[ind];
   }
+  /// INFO: 以下两个 const 重载不做 pushDown，而是自顶向下复合祖先上的懒标记，
+  /// 不修改树，因此多个线程可以同时查询（修改仍需与查询互斥，如读写锁）
+  /// 非 const 对象需要通过 const 引用（如 std::as_const）才会调用它们
+  auto query(int64_t ind) const -> T {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("SegmentTree::query index out of range");
+    }
+    ind += tree_size_;
+    F pending = id();
+    for (int i = height_log_; i >= 1; i--) {
+      pending = composition(pending, lazy_[ind >> i]);
+    }
+    return mapping(pending, tree_[ind]);
+  }
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("SegmentTree::query invalid interval");
+    }
+    return queryConst(1, 0, tree_size_, left_bound, right_bound + 1, id());
+  }
   // 区间为闭区间 [L, R]，但内部实现的时候使用半开区间 [L, R+1)
-  auto query(int left_bound, int right_bound) -> T {
+  auto query(int64_t left_bound, int64_t right_bound) -> T {
     if (left_bound < 0 || right_bound >= arr_size_ ||
         left_bound > right_bound) {
       throw std::out_of_range("SegmentTree::query invalid interval");
@@ -149,6 +335,227 @@ public:
     }
     return op(lans, rans);
   }
+  /// INFO: 树上二分，pred 必须满足 pred(e()) 为真且关于区间单调
+  // 返回第一个使 pred(query(l, r)) 为假的 r，不存在时返回 size()，
+  // 即 [l, r - 1] 是从 l 开始满足 pred 的最长区间；l 可以等于 size()
+  template <typename Pred>
+  auto maxRight(int64_t left_bound, Pred pred) -> int64_t {
+    if (left_bound < 0 || left_bound > arr_size_) {
+      throw std::out_of_range("SegmentTree::maxRight invalid index");
+    }
+    if (left_bound == arr_size_) {
+      return arr_size_;
+    }
+    left_bound += tree_size_;
+    for (int i = height_log_; i >= 1; i--) {
+      pushDown(left_bound >> i);
+    }
+    T sum = e();
+    do {
+      while ((left_bound & 1) == 0) {
+        left_bound >>= 1;
+      }
+      if (!pred(op(sum, tree_[left_bound]))) {
+        while (left_bound < tree_size_) {
+          pushDown(left_bound);
+          left_bound *= 2;
+          if (pred(op(sum, tree_[left_bound]))) {
+            sum = op(sum, tree_[left_bound++]);
+          }
+        }
+        return left_bound - tree_size_;
+      }
+      sum = op(sum, tree_[left_bound++]);
+    } while ((left_bound & -left_bound) != left_bound);
+    return arr_size_;
+  }
+  // 返回最小的 l 使 pred(query(l, r)) 为真，连 [r, r] 都不满足时返回 r + 1；
+  // r 可以等于 -1
+  template <typename Pred>
+  auto minLeft(int64_t right_bound, Pred pred) -> int64_t {
+    if (right_bound < -1 || right_bound >= arr_size_) {
+      throw std::out_of_range("SegmentTree::minLeft invalid index");
+    }
+    if (right_bound == -1) {
+      return 0;
+    }
+    right_bound += tree_size_ + 1;
+    for (int i = height_log_; i >= 1; i--) {
+      pushDown((right_bound - 1) >> i);
+    }
+    T sum = e();
+    do {
+      right_bound--;
+      while (right_bound > 1 && (right_bound & 1) != 0) {
+        right_bound >>= 1;
+      }
+      if (!pred(op(tree_[right_bound], sum))) {
+        while (right_bound < tree_size_) {
+          pushDown(right_bound);
+          right_bound = right_bound * 2 + 1;
+          if (pred(op(tree_[right_bound], sum))) {
+            sum = op(tree_[right_bound--], sum);
+          }
+        }
+        return right_bound + 1 - tree_size_;
+      }
+      sum = op(tree_[right_bound], sum);
+    } while ((right_bound & -right_bound) != right_bound);
+    return 0;
+  }
+};
+
+/// INFO: 不带懒标记的线段树，只支持单点修改、区间查询
+/// 没有 lazy_ 数组和 pushDown，查询是 const 的，可以被多个线程同时调用
+template <typename T, T (*op)(T, T), T (*e)()>
+class MonoidSegmentTree {
+private:
+  int64_t arr_size_, tree_size_;
+  std::vector<T> tree_;
+  void pushUp(int64_t ind) {
+    tree_[ind] = op(tree_[ind * 2], tree_[ind * 2 + 1]);
+  }
+
+public:
+  explicit MonoidSegmentTree(int64_t arr_size)
+      : arr_size_(arr_size),
+        tree_size_(static_cast<int64_t>(bitop::bitCeil(arr_size_))) {
+    if (arr_size < 0) {
+      throw std::invalid_argument("MonoidSegmentTree requires n >= 0");
+    }
+    tree_.resize(static_cast<size_t>(tree_size_) * 2, e());
+  }
+  // 数组下标从 0 开始
+  explicit MonoidSegmentTree(const std::vector<T> &arr)
+      : arr_size_(static_cast<int64_t>(arr.size())),
+        tree_size_(static_cast<int64_t>(bitop::bitCeil(arr_size_))) {
+    tree_.resize(static_cast<size_t>(tree_size_) * 2, e());
+    for (int64_t i = 0; i < arr_size_; i++) {
+      tree_[tree_size_ + i] = arr[i];
+    }
+    for (int64_t i = tree_size_ - 1; i > 0; i--) {
+      pushUp(i);
+    }
+  }
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  void assign(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("MonoidSegmentTree::assign index out of range");
+    }
+    ind += tree_size_;
+    tree_[ind] = val;
+    for (ind >>= 1; ind > 0; ind >>= 1) {
+      pushUp(ind);
+    }
+  }
+  // 用 values 覆盖 [l, l + values.size())，逐层只重算受影响的一段节点，
+  // O(k + log n)
+  void assignRange(int64_t left_bound, const std::vector<T> &values) {
+    auto count = static_cast<int64_t>(values.size());
+    if (left_bound < 0 || left_bound > arr_size_ ||
+        count > arr_size_ - left_bound) {
+      throw std::out_of_range(
+          "MonoidSegmentTree::assignRange invalid interval");
+    }
+    if (count == 0) {
+      return;
+    }
+    left_bound += tree_size_;
+    int64_t right_bound = left_bound + count - 1;
+    std::copy(values.begin(), values.end(), tree_.begin() + left_bound);
+    for (left_bound >>= 1, right_bound >>= 1; left_bound > 0;
+         left_bound >>= 1, right_bound >>= 1) {
+      for (int64_t j = left_bound; j <= right_bound; j++) {
+        pushUp(j);
+      }
+    }
+  }
+  auto query(int64_t ind) const -> T {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("MonoidSegmentTree::query index out of range");
+    }
+    return tree_[tree_size_ + ind];
+  }
+  // 区间为闭区间 [L, R]，但内部实现的时候使用半开区间 [L, R+1)
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("MonoidSegmentTree::query invalid interval");
+    }
+    left_bound += tree_size_;
+    right_bound += tree_size_ + 1;
+    T lans = e();
+    T rans = e();
+    while (left_bound < right_bound) {
+      if ((left_bound & 1) != 0) {
+        lans = op(lans, tree_[left_bound++]);
+      }
+      if ((right_bound & 1) != 0) {
+        rans = op(tree_[--right_bound], rans);
+      }
+      left_bound >>= 1;
+      right_bound >>= 1;
+    }
+    return op(lans, rans);
+  }
+  // 整个数组的和
+  auto queryAll() const -> T { return tree_[1]; }
+  // 树上二分，语义同 SegmentTree::maxRight / minLeft
+  template <typename Pred>
+  auto maxRight(int64_t left_bound, Pred pred) const -> int64_t {
+    if (left_bound < 0 || left_bound > arr_size_) {
+      throw std::out_of_range("MonoidSegmentTree::maxRight invalid index");
+    }
+    if (left_bound == arr_size_) {
+      return arr_size_;
+    }
+    left_bound += tree_size_;
+    T sum = e();
+    do {
+      while ((left_bound & 1) == 0) {
+        left_bound >>= 1;
+      }
+      if (!pred(op(sum, tree_[left_bound]))) {
+        while (left_bound < tree_size_) {
+          left_bound *= 2;
+          if (pred(op(sum, tree_[left_bound]))) {
+            sum = op(sum, tree_[left_bound++]);
+          }
+        }
+        return left_bound - tree_size_;
+      }
+      sum = op(sum, tree_[left_bound++]);
+    } while ((left_bound & -left_bound) != left_bound);
+    return arr_size_;
+  }
+  template <typename Pred>
+  auto minLeft(int64_t right_bound, Pred pred) const -> int64_t {
+    if (right_bound < -1 || right_bound >= arr_size_) {
+      throw std::out_of_range("MonoidSegmentTree::minLeft invalid index");
+    }
+    if (right_bound == -1) {
+      return 0;
+    }
+    right_bound += tree_size_ + 1;
+    T sum = e();
+    do {
+      right_bound--;
+      while (right_bound > 1 && (right_bound & 1) != 0) {
+        right_bound >>= 1;
+      }
+      if (!pred(op(tree_[right_bound], sum))) {
+        while (right_bound < tree_size_) {
+          right_bound = right_bound * 2 + 1;
+          if (pred(op(tree_[right_bound], sum))) {
+            sum = op(tree_[right_bound--], sum);
+          }
+        }
+        return right_bound + 1 - tree_size_;
+      }
+      sum = op(tree_[right_bound], sum);
+    } while ((right_bound & -right_bound) != right_bound);
+    return 0;
+  }
 };
 }  // namespace mystd::segment_tree
 
@@ -0,0 +1,322 @@
+#ifndef SEGMENTTREEBEATS_HPP
+#define SEGMENTTREEBEATS_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "BitOperation.hpp"
+
+namespace mystd::segment_tree {
+
+/// INFO: Segment Tree Beats（吉司机线段树），支持区间取 min、区间取 max、
+/// 区间加，以及区间和、区间最大值、区间最小值查询，均摊 O(log^2 n)
+/// 每个节点维护最大值、严格次大值、最大值个数，以及对称的最小值三元组：
+/// 区间取 min(x) 时若 次大值 < x < 最大值，只需修改最大值及其个数对应的和，
+/// 否则继续向下递归；这种递归的总次数可以用势能分析摊还
+/// 区间和与元素使用同一个类型 T，调用者需保证不会溢出
+template <typename T>
+class SegmentTreeBeats {
+  static_assert(std::is_arithmetic_v<T>,
+                "SegmentTreeBeats requires an arithmetic type");
+
+private:
+  // 区间内所有元素相等时没有严格次大值、次小值，用 has_max2_、has_min2_ 标记，
+  // 而不是用某个 T 的值作哨兵：任何哨兵都可能是合法的元素（如无符号数的 0）
+  struct Node {
+    T sum_;
+    T max1_, max2_, min1_, min2_;
+    int64_t max_count_, min_count_;
+    T add_;
+    bool has_max2_, has_min2_;
+  };
+
+  int64_t arr_size_;
+  // 递归建树，节点 ind 的子节点为 2 * ind 和 2 * ind + 1，
+  // 深度不超过 log2(bitCeil(n))，因此 2 * bitCeil(n) 个节点足够
+  std::vector<Node> tree_;
+
+  static auto leaf(T val) -> Node {
+    return Node{val, val, val, val, val, 1, 1, T{}, false, false};
+  }
+  void pushUp(int64_t ind) {
+    const Node &lhs = tree_[ind * 2];
+    const Node &rhs = tree_[ind * 2 + 1];
+    Node &cur = tree_[ind];
+    cur.sum_ = lhs.sum_ + rhs.sum_;
+    if (lhs.max1_ == rhs.max1_) {
+      cur.max1_ = lhs.max1_;
+      cur.max_count_ = lhs.max_count_ + rhs.max_count_;
+      cur.has_max2_ = lhs.has_max2_ || rhs.has_max2_;
+      if (!rhs.has_max2_) {
+        cur.max2_ = lhs.max2_;
+      } else if (!lhs.has_max2_) {
+        cur.max2_ = rhs.max2_;
+      } else {
+        cur.max2_ = lhs.max2_ > rhs.max2_ ? lhs.max2_ : rhs.max2_;
+      }
+    } else {
+      // 较小一侧的最大值一定是次大值的候选
+      const Node &big = lhs.max1_ > rhs.max1_ ? lhs : rhs;
+      const Node &small = lhs.max1_ > rhs.max1_ ? rhs : lhs;
+      cur.max1_ = big.max1_;
+      cur.max_count_ = big.max_count_;
+      cur.has_max2_ = true;
+      cur.max2_ = big.has_max2_ && big.max2_ > small.max1_ ? big.max2_
+                                                           : small.max1_;
+    }
+    if (lhs.min1_ == rhs.min1_) {
+      cur.min1_ = lhs.min1_;
+      cur.min_count_ = lhs.min_count_ + rhs.min_count_;
+      cur.has_min2_ = lhs.has_min2_ || rhs.has_min2_;
+      if (!rhs.has_min2_) {
+        cur.min2_ = lhs.min2_;
+      } else if (!lhs.has_min2_) {
+        cur.min2_ = rhs.min2_;
+      } else {
+        cur.min2_ = lhs.min2_ < rhs.min2_ ? lhs.min2_ : rhs.min2_;
+      }
+    } else {
+      const Node &small = lhs.min1_ < rhs.min1_ ? lhs : rhs;
+      const Node &big = lhs.min1_ < rhs.min1_ ? rhs : lhs;
+      cur.min1_ = small.min1_;
+      cur.min_count_ = small.min_count_;
+      cur.has_min2_ = true;
+      cur.min2_ = small.has_min2_ && small.min2_ < big.min1_ ? small.min2_
+                                                             : big.min1_;
+    }
+  }
+  void applyAdd(int64_t ind, int64_t len, T val) {
+    Node &cur = tree_[ind];
+    cur.sum_ += val * static_cast<T>(len);
+    cur.max1_ += val;
+    cur.max2_ += val;
+    cur.min1_ += val;
+    cur.min2_ += val;
+    cur.add_ += val;
+  }
+  // 要求 max2 < val < max1（或没有次大值），只有等于最大值的元素会变
+  void applyChmin(int64_t ind, T val) {
+    Node &cur = tree_[ind];
+    cur.sum_ -= (cur.max1_ - val) * static_cast<T>(cur.max_count_);
+    // 最大值同时也是最小值或次小值时要一起修改
+    if (cur.min1_ == cur.max1_) {
+      cur.min1_ = val;
+    } else if (cur.has_min2_ && cur.min2_ == cur.max1_) {
+      cur.min2_ = val;
+    }
+    cur.max1_ = val;
+  }
+  // 要求 min1 < val < min2（或没有次小值），只有等于最小值的元素会变
+  void applyChmax(int64_t ind, T val) {
+    Node &cur = tree_[ind];
+    cur.sum_ += (val - cur.min1_) * static_cast<T>(cur.min_count_);
+    if (cur.max1_ == cur.min1_) {
+      cur.max1_ = val;
+    } else if (cur.has_max2_ && cur.max2_ == cur.min1_) {
+      cur.max2_ = val;
+    }
+    cur.min1_ = val;
+  }
+  // 先下传加法标记，再用父节点的最值约束子节点
+  void pushDown(int64_t ind, int64_t left_len, int64_t right_len) {
+    Node &cur = tree_[ind];
+    if (cur.add_ != T{}) {
+      applyAdd(ind * 2, left_len, cur.add_);
+      applyAdd(ind * 2 + 1, right_len, cur.add_);
+      cur.add_ = T{};
+    }
+    for (int64_t child : {ind * 2, ind * 2 + 1}) {
+      if (tree_[child].max1_ > cur.max1_) {
+        applyChmin(child, cur.max1_);
+      }
+      if (tree_[child].min1_ < cur.min1_) {
+        applyChmax(child, cur.min1_);
+      }
+    }
+  }
+
+  // 节点 ind 管辖 [node_left, node_right)
+  void build(const std::vector<T> &arr, int64_t ind, int64_t node_left,
+             int64_t node_right) {
+    if (node_right - node_left == 1) {
+      tree_[ind] = leaf(arr[node_left]);
+      return;
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    build(arr, ind * 2, node_left, mid);
+    build(arr, ind * 2 + 1, mid, node_right);
+    tree_[ind].add_ = T{};
+    pushUp(ind);
+  }
+  void assignPoint(int64_t ind, int64_t node_left, int64_t node_right,
+                   int64_t pos, T val) {
+    if (node_right - node_left == 1) {
+      tree_[ind] = leaf(val);
+      return;
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    pushDown(ind, mid - node_left, node_right - mid);
+    if (pos < mid) {
+      assignPoint(ind * 2, node_left, mid, pos, val);
+    } else {
+      assignPoint(ind * 2 + 1, mid, node_right, pos, val);
+    }
+    pushUp(ind);
+  }
+  void chminRange(int64_t ind, int64_t node_left, int64_t node_right,
+                  int64_t left_bound, int64_t right_bound, T val) {
+    if (tree_[ind].max1_ <= val) {
+      return;
+    }
+    if (left_bound <= node_left && node_right <= right_bound &&
+        (!tree_[ind].has_max2_ || tree_[ind].max2_ < val)) {
+      applyChmin(ind, val);
+      return;
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    pushDown(ind, mid - node_left, node_right - mid);
+    if (left_bound < mid) {
+      chminRange(ind * 2, node_left, mid, left_bound, right_bound, val);
+    }
+    if (mid < right_bound) {
+      chminRange(ind * 2 + 1, mid, node_right, left_bound, right_bound, val);
+    }
+    pushUp(ind);
+  }
+  void chmaxRange(int64_t ind, int64_t node_left, int64_t node_right,
+                  int64_t left_bound, int64_t right_bound, T val) {
+    if (tree_[ind].min1_ >= val) {
+      return;
+    }
+    if (left_bound <= node_left && node_right <= right_bound &&
+        (!tree_[ind].has_min2_ || tree_[ind].min2_ > val)) {
+      applyChmax(ind, val);
+      return;
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    pushDown(ind, mid - node_left, node_right - mid);
+    if (left_bound < mid) {
+      chmaxRange(ind * 2, node_left, mid, left_bound, right_bound, val);
+    }
+    if (mid < right_bound) {
+      chmaxRange(ind * 2 + 1, mid, node_right, left_bound, right_bound, val);
+    }
+    pushUp(ind);
+  }
+  void addRange(int64_t ind, int64_t node_left, int64_t node_right,
+                int64_t left_bound, int64_t right_bound, T val) {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      applyAdd(ind, node_right - node_left, val);
+      return;
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    pushDown(ind, mid - node_left, node_right - mid);
+    if (left_bound < mid) {
+      addRange(ind * 2, node_left, mid, left_bound, right_bound, val);
+    }
+    if (mid < right_bound) {
+      addRange(ind * 2 + 1, mid, node_right, left_bound, right_bound, val);
+    }
+    pushUp(ind);
+  }
+  // Getter 从完整覆盖的节点中取值，Merge 合并左右两部分的结果
+  template <typename Getter, typename Merge>
+  auto queryRange(int64_t ind, int64_t node_left, int64_t node_right,
+                  int64_t left_bound, int64_t right_bound, Getter get,
+                  Merge merge) -> T {
+    if (left_bound <= node_left && node_right <= right_bound) {
+      return get(tree_[ind]);
+    }
+    int64_t mid = (node_left + node_right) / 2;
+    pushDown(ind, mid - node_left, node_right - mid);
+    if (right_bound <= mid) {
+      return queryRange(ind * 2, node_left, mid, left_bound, right_bound, get,
+                        merge);
+    }
+    if (mid <= left_bound) {
+      return queryRange(ind * 2 + 1, mid, node_right, left_bound, right_bound,
+                        get, merge);
+    }
+    return merge(queryRange(ind * 2, node_left, mid, left_bound, right_bound,
+                            get, merge),
+                 queryRange(ind * 2 + 1, mid, node_right, left_bound,
+                            right_bound, get, merge));
+  }
+  void checkInterval(int64_t left_bound, int64_t right_bound,
+                     const char *msg) const {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range(msg);
+    }
+  }
+
+public:
+  explicit SegmentTreeBeats(int64_t arr_size)
+      : SegmentTreeBeats(std::vector<T>(arr_size, T{})) {}
+  // 数组下标从 0 开始
+  explicit SegmentTreeBeats(const std::vector<T> &arr)
+      : arr_size_(static_cast<int64_t>(arr.size())),
+        tree_(static_cast<size_t>(bitop::bitCeil(arr.size())) * 2) {
+    if (arr_size_ > 0) {
+      build(arr, 1, 0, arr_size_);
+    }
+  }
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+
+  void assign(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("SegmentTreeBeats::assign index out of range");
+    }
+    assignPoint(1, 0, arr_size_, ind, val);
+  }
+  // 以下修改与查询的区间均为闭区间 [L, R]
+  // a[i] <- min(a[i], val)
+  void chmin(int64_t left_bound, int64_t right_bound, T val) {
+    checkInterval(left_bound, right_bound,
+                  "SegmentTreeBeats::chmin invalid interval");
+    chminRange(1, 0, arr_size_, left_bound, right_bound + 1, val);
+  }
+  // a[i] <- max(a[i], val)
+  void chmax(int64_t left_bound, int64_t right_bound, T val) {
+    checkInterval(left_bound, right_bound,
+                  "SegmentTreeBeats::chmax invalid interval");
+    chmaxRange(1, 0, arr_size_, left_bound, right_bound + 1, val);
+  }
+  // a[i] <- a[i] + val
+  void add(int64_t left_bound, int64_t right_bound, T val) {
+    checkInterval(left_bound, right_bound,
+                  "SegmentTreeBeats::add invalid interval");
+    addRange(1, 0, arr_size_, left_bound, right_bound + 1, val);
+  }
+
+  auto query(int64_t ind) -> T { return querySum(ind, ind); }
+  auto querySum(int64_t left_bound, int64_t right_bound) -> T {
+    checkInterval(left_bound, right_bound,
+                  "SegmentTreeBeats::querySum invalid interval");
+    return queryRange(
+        1, 0, arr_size_, left_bound, right_bound + 1,
+        [](const Node &cur) { return cur.sum_; },
+        [](T lhs, T rhs) { return lhs + rhs; });
+  }
+  auto queryMax(int64_t left_bound, int64_t right_bound) -> T {
+    checkInterval(left_bound, right_bound,
+                  "SegmentTreeBeats::queryMax invalid interval");
+    return queryRange(
+        1, 0, arr_size_, left_bound, right_bound + 1,
+        [](const Node &cur) { return cur.max1_; },
+        [](T lhs, T rhs) { return lhs > rhs ? lhs : rhs; });
+  }
+  auto queryMin(int64_t left_bound, int64_t right_bound) -> T {
+    checkInterval(left_bound, right_bound,
+                  "SegmentTreeBeats::queryMin invalid interval");
+    return queryRange(
+        1, 0, arr_size_, left_bound, right_bound + 1,
+        [](const Node &cur) { return cur.min1_; },
+        [](T lhs, T rhs) { return lhs < rhs ? lhs : rhs; });
+  }
+};
+}  // namespace mystd::segment_tree
+
+#endif  // SEGMENTTREEBEATS_HPP
@@ -0,0 +1,168 @@
+#ifndef SPARSEFENWICKTREE_HPP
+#define SPARSEFENWICKTREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "BitOperation.hpp"
+#include "FenwickTree.hpp"
+
+namespace mystd::fenwick_tree {
+
+/// INFO: 下标为 uint64_t 的稀疏树状数组，只为修改路径上实际用到的结点分配空间
+/// 结点存放在哈希表中，单点修改、前缀查询都是 O(log U) 次哈希表访问，
+/// 空间为 O(修改次数 · log U)；下标范围为 [0, universe)
+template <typename Group>
+class SparseFenwickTree {
+public:
+  using ValueType = typename Group::ValueType;
+
+private:
+  using T = ValueType;
+  uint64_t universe_;
+  std::unordered_map<uint64_t, T> tree_;
+  Group group_;
+
+public:
+  // 默认覆盖全部 64 位下标（最大的下标 2^64 - 1 除外）
+  explicit SparseFenwickTree(uint64_t universe = UINT64_MAX,
+                             const Group &group = Group())
+      : universe_(universe), group_(group) {}
+
+  [[nodiscard]] auto universe() const -> uint64_t { return universe_; }
+  // 已分配的结点个数
+  [[nodiscard]] auto nodeCount() const -> size_t { return tree_.size(); }
+
+  void apply(uint64_t ind, T val) {
+    if (ind >= universe_) {
+      throw std::out_of_range("SparseFenwickTree::apply invalid index");
+    }
+    // 树中结点编号从 1 开始，取值范围 [1, universe]
+    for (uint64_t i = ind + 1;;) {
+      auto it = tree_.try_emplace(i, group_.identity()).first;
+      it->second = group_.op(it->second, val);
+      uint64_t step = bitop::lowbit(i);
+      if (i > universe_ - step) {
+        break;
+      }
+      i += step;
+    }
+  }
+  // 前缀 [0, ind] 的和
+  auto query(uint64_t ind) const -> T {
+    if (ind >= universe_) {
+      throw std::out_of_range("SparseFenwickTree::query invalid index");
+    }
+    T result = group_.identity();
+    for (uint64_t i = ind + 1; i > 0; i -= bitop::lowbit(i)) {
+      auto it = tree_.find(i);
+      if (it != tree_.end()) {
+        result = group_.op(result, it->second);
+      }
+    }
+    return result;
+  }
+  // 区间为闭区间 [L, R]
+  auto query(uint64_t left_bound, uint64_t right_bound) const -> T {
+    if (right_bound >= universe_ || left_bound > right_bound) {
+      throw std::out_of_range("SparseFenwickTree::query invalid interval");
+    }
+    T result = query(right_bound);
+    return left_bound == 0 ? result : group_.inv(result, query(left_bound - 1));
+  }
+};
+
+/// INFO: 离线坐标压缩的树状数组：先给出全部可能修改的键，排序去重后
+/// 映射到稠密的 BasicFenwickTree 上，建树 O(n log n)，之后每次操作 O(log n)
+/// 查询可以使用任意键，结果为不超过该键的已知键上的和
+template <typename Group>
+class CompressedFenwickTree {
+public:
+  using ValueType = typename Group::ValueType;
+
+private:
+  using T = ValueType;
+  std::vector<uint64_t> keys_;
+  BasicFenwickTree<Group> tree_;
+  Group group_;
+
+  static auto compress(std::vector<uint64_t> keys) -> std::vector<uint64_t> {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+  }
+
+  // 按压缩后的顺序汇总初始值，重复的键用 op 合并
+  static auto gather(const std::vector<uint64_t> &sorted,
+                     const std::vector<uint64_t> &keys,
+                     const std::vector<T> &values, const Group &grp)
+      -> std::vector<T> {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument(
+          "CompressedFenwickTree keys and values size mismatch");
+    }
+    std::vector<T> dense(sorted.size(), grp.identity());
+    for (size_t i = 0; i < keys.size(); i++) {
+      size_t pos = std::lower_bound(sorted.begin(), sorted.end(), keys[i]) -
+                   sorted.begin();
+      dense[pos] = grp.op(dense[pos], values[i]);
+    }
+    return dense;
+  }
+
+  // 不超过 key 的已知键个数
+  auto countNotGreater(uint64_t key) const -> int64_t {
+    return std::upper_bound(keys_.begin(), keys_.end(), key) - keys_.begin();
+  }
+
+public:
+  explicit CompressedFenwickTree(const std::vector<uint64_t> &keys,
+                                 const Group &group = Group())
+      : keys_(compress(keys)),
+        tree_(static_cast<int64_t>(keys_.size()), group),
+        group_(group) {}
+  // values[i] 为 keys[i] 上的初始值
+  CompressedFenwickTree(const std::vector<uint64_t> &keys,
+                        const std::vector<T> &values,
+                        const Group &group = Group())
+      : keys_(compress(keys)),
+        tree_(gather(keys_, keys, values, group), group),
+        group_(group) {}
+
+  // 去重后的键个数
+  [[nodiscard]] auto size() const -> int64_t { return tree_.size(); }
+  [[nodiscard]] auto keys() const -> const std::vector<uint64_t> & {
+    return keys_;
+  }
+  [[nodiscard]] auto contains(uint64_t key) const -> bool {
+    return std::binary_search(keys_.begin(), keys_.end(), key);
+  }
+
+  // key 必须在建树时给出过
+  void apply(uint64_t key, T val) {
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) {
+      throw std::out_of_range("CompressedFenwickTree::apply unknown key");
+    }
+    tree_.apply(it - keys_.begin(), val);
+  }
+  // 所有不超过 key 的键上的和
+  auto query(uint64_t key) const -> T {
+    return tree_.query(countNotGreater(key) - 1);
+  }
+  // 所有落在闭区间 [L, R] 内的键上的和
+  auto query(uint64_t left_bound, uint64_t right_bound) const -> T {
+    if (left_bound > right_bound) {
+      throw std::out_of_range("CompressedFenwickTree::query invalid interval");
+    }
+    T result = query(right_bound);
+    return left_bound == 0 ? result : group_.inv(result, query(left_bound - 1));
+  }
+};
+}  // namespace mystd::fenwick_tree
+
+#endif  // SPARSEFENWICKTREE_HPP
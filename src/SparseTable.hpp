@@ -0,0 +1,143 @@
+#ifndef SPARSETABLE_HPP
+#define SPARSETABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "BitOperation.hpp"
+
+namespace mystd::sparse_table {
+
+/// INFO: 静态数组上的 ST 表，op 必须满足结合律且幂等（op(x, x) == x），
+/// 例如 min、max、gcd、按位与、按位或
+/// 第 k 层第 i 项为 [i, i + 2^k) 上的和，建表 O(n log n)；查询用两段长为
+/// 2^floorLog(len) 的、可能重叠的区间覆盖 [L, R]，O(1)
+template <typename T, T (*op)(T, T)>
+class SparseTable {
+private:
+  int64_t arr_size_;
+  // 按层连续存放，第 k 层从 k * arr_size_ 开始
+  std::vector<T> table_;
+
+public:
+  // 数组下标从 0 开始
+  explicit SparseTable(const std::vector<T> &arr)
+      : arr_size_(static_cast<int64_t>(arr.size())), table_(arr) {
+    if (arr_size_ == 0) {
+      return;
+    }
+    auto levels = static_cast<int64_t>(bitop::floorLog(arr_size_)) + 1;
+    table_.resize(static_cast<size_t>(levels * arr_size_));
+    for (int64_t k = 1; k < levels; k++) {
+      const T *prev = table_.data() + (k - 1) * arr_size_;
+      T *cur = table_.data() + k * arr_size_;
+      int64_t half = int64_t{1} << (k - 1);
+      for (int64_t i = 0; i + (half << 1) <= arr_size_; i++) {
+        cur[i] = op(prev[i], prev[i + half]);
+      }
+    }
+  }
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+
+  auto query(int64_t ind) const -> T {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("SparseTable::query index out of range");
+    }
+    return table_[ind];
+  }
+  // 区间为闭区间 [L, R]
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("SparseTable::query invalid interval");
+    }
+    auto k = static_cast<int64_t>(
+        bitop::floorLog(static_cast<uint64_t>(right_bound - left_bound + 1)));
+    const T *row = table_.data() + k * arr_size_;
+    return op(row[left_bound], row[right_bound - (int64_t{1} << k) + 1]);
+  }
+};
+
+/// INFO: 分块的 ST 表，额外空间 O(n)：每块存块内前缀和与后缀和，
+/// 块的总和之上再建一张 SparseTable，占 O(n / BLOCK · log n)
+/// 跨块的查询为 后缀 + 中间整块 + 前缀，O(1)；落在同一块内的查询直接扫描，
+/// 最坏 O(BLOCK)
+template <typename T, T (*op)(T, T), size_t BLOCK = 32>
+class BlockSparseTable {
+  static_assert(BLOCK > 0, "BlockSparseTable requires BLOCK > 0");
+
+private:
+  static constexpr auto B = static_cast<int64_t>(BLOCK);
+
+  int64_t arr_size_;
+  std::vector<T> arr_;
+  // prefix_[i] 为 i 所在块的块首到 i 的和，suffix_[i] 为 i 到块尾的和
+  std::vector<T> prefix_, suffix_;
+  SparseTable<T, op> top_;
+
+  static auto blockTotals(const std::vector<T> &arr) -> std::vector<T> {
+    std::vector<T> totals;
+    totals.reserve((arr.size() + BLOCK - 1) / BLOCK);
+    for (size_t i = 0; i < arr.size(); i++) {
+      if (i % BLOCK == 0) {
+        totals.push_back(arr[i]);
+      } else {
+        totals.back() = op(totals.back(), arr[i]);
+      }
+    }
+    return totals;
+  }
+
+public:
+  explicit BlockSparseTable(const std::vector<T> &arr)
+      : arr_size_(static_cast<int64_t>(arr.size())),
+        arr_(arr),
+        prefix_(arr),
+        suffix_(arr),
+        top_(blockTotals(arr)) {
+    for (int64_t i = 1; i < arr_size_; i++) {
+      if (i % B != 0) {
+        prefix_[i] = op(prefix_[i - 1], arr_[i]);
+      }
+    }
+    for (int64_t i = arr_size_ - 2; i >= 0; i--) {
+      if ((i + 1) % B != 0) {
+        suffix_[i] = op(arr_[i], suffix_[i + 1]);
+      }
+    }
+  }
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+
+  auto query(int64_t ind) const -> T {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("BlockSparseTable::query index out of range");
+    }
+    return arr_[ind];
+  }
+  // 区间为闭区间 [L, R]
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("BlockSparseTable::query invalid interval");
+    }
+    int64_t left_block = left_bound / B;
+    int64_t right_block = right_bound / B;
+    if (left_block == right_block) {
+      T result = arr_[left_bound];
+      for (int64_t i = left_bound + 1; i <= right_bound; i++) {
+        result = op(result, arr_[i]);
+      }
+      return result;
+    }
+    T result = suffix_[left_bound];
+    if (right_block - left_block > 1) {
+      result = op(result, top_.query(left_block + 1, right_block - 1));
+    }
+    return op(result, prefix_[right_bound]);
+  }
+};
+}  // namespace mystd::sparse_table
+
+#endif  // SPARSETABLE_HPP
@@ -0,0 +1,236 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "BitOperation.hpp"
+#include "Vector.hpp"
+#include "common.h"
+
+namespace mystd::timer_wheel {
+
+// 定时器句柄：节点下标 + 代数，节点被回收后旧句柄自动失效
+struct TimerHandle {
+  uint32_t index_;
+  uint32_t generation_;
+};
+
+/// INFO: 分层时间轮，时间以无符号整数 tick 表示
+/// 每层 64 个槽，第 i 层一个槽覆盖 64^i 个 tick
+/// 超出最高层范围的定时器放在溢出桶中，每当最高层转完一圈时重新放置
+/// schedule / cancel 为 O(1)，advance 只在有定时器到期或需要下放的 tick 上停留
+template <typename Callback = std::function<void()>, size_t LEVELS = 4>
+class TimerWheel {
+  static_assert(LEVELS > 0 && LEVELS * 6 < 64, "TimerWheel: invalid LEVELS");
+
+private:
+  static constexpr size_t SLOT_BITS = 6;
+  static constexpr size_t SLOTS = 1ULL << SLOT_BITS;
+  static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+  static constexpr size_t OVERFLOW_BUCKET = LEVELS * SLOTS;
+  static constexpr uint32_t NIL = UINT32_MAX;
+
+  // 与 LinkList 的节点相同的双向链接，但用池中的下标代替指针
+  struct Node {
+    uint64_t deadline_;
+    uint32_t nxt_, pre_;
+    uint32_t bucket_;  // 所在的桶，空闲节点为 NIL
+    uint32_t generation_;
+    Callback callback_;
+  };
+
+  vector::Vector<Node> nodes_;
+  vector::Vector<uint32_t> heads_;
+  // 每层 64 个槽的占用情况，用于跳过空槽
+  std::array<bitop::ull, LEVELS> occupied_{};
+  uint32_t free_head_ = NIL;
+  size_t pending_ = 0;
+  uint64_t now_;
+
+  static auto levelShift(size_t level) -> size_t { return level * SLOT_BITS; }
+  // 第 pos 个槽之后（不含）的所有槽
+  static auto slotsAfter(uint64_t pos) -> bitop::ull {
+    return pos == SLOT_MASK ? 0 : (~0ULL << (pos + 1));
+  }
+
+  void link(uint32_t idx, uint32_t bucket) {
+    Node &node = nodes_[idx];
+    node.bucket_ = bucket;
+    node.pre_ = NIL;
+    node.nxt_ = heads_[bucket];
+    if (node.nxt_ != NIL) {
+      nodes_[node.nxt_].pre_ = idx;
+    }
+    heads_[bucket] = idx;
+    if (bucket < OVERFLOW_BUCKET) {
+      occupied_[bucket / SLOTS] |= 1ULL << (bucket % SLOTS);
+    }
+  }
+
+  void unlink(uint32_t idx) {
+    Node &node = nodes_[idx];
+    if (node.pre_ != NIL) {
+      nodes_[node.pre_].nxt_ = node.nxt_;
+    } else {
+      heads_[node.bucket_] = node.nxt_;
+    }
+    if (node.nxt_ != NIL) {
+      nodes_[node.nxt_].pre_ = node.pre_;
+    }
+    if (heads_[node.bucket_] == NIL && node.bucket_ < OVERFLOW_BUCKET) {
+      occupied_[node.bucket_ / SLOTS] &= ~(1ULL << (node.bucket_ % SLOTS));
+    }
+    node.bucket_ = NIL;
+  }
+
+  void release(uint32_t idx) {
+    Node &node = nodes_[idx];
+    node.bucket_ = NIL;
+    node.generation_++;
+    node.callback_ = Callback();
+    node.nxt_ = free_head_;
+    free_head_ = idx;
+  }
+
+  // 到期时间与当前时间最高的不同位决定所在层：同一层内只需看该层对应的 6 位
+  void place(uint32_t idx) {
+    uint64_t deadline = nodes_[idx].deadline_;
+    uint64_t diff = deadline ^ now_;
+    size_t level = 0;
+    while (level < LEVELS && (diff >> levelShift(level + 1)) != 0) {
+      level++;
+    }
+    if (level == LEVELS) {
+      link(idx, OVERFLOW_BUCKET);
+      return;
+    }
+    auto slot = (deadline >> levelShift(level)) & SLOT_MASK;
+    link(idx, static_cast<uint32_t>(level * SLOTS + slot));
+  }
+
+  // 把整个桶摘下后重新放置，定时器会落到更低的层
+  void cascade(size_t bucket) {
+    uint32_t cur = heads_[bucket];
+    heads_[bucket] = NIL;
+    if (bucket < OVERFLOW_BUCKET) {
+      occupied_[bucket / SLOTS] &= ~(1ULL << (bucket % SLOTS));
+    }
+    while (cur != NIL) {
+      uint32_t nxt = nodes_[cur].nxt_;
+      place(cur);
+      cur = nxt;
+    }
+  }
+
+  auto fire(size_t bucket) -> size_t {
+    size_t fired = 0;
+    while (heads_[bucket] != NIL) {
+      uint32_t idx = heads_[bucket];
+      unlink(idx);
+      // 回调中可能继续 schedule 导致节点池扩容，先把回调移出来
+      Callback callback = std::move(nodes_[idx].callback_);
+      release(idx);
+      pending_--;
+      fired++;
+      callback();
+    }
+    return fired;
+  }
+
+  // 下一个需要处理（有定时器到期或需要下放）的 tick
+  [[nodiscard]] auto nextEventTick() const -> uint64_t {
+    uint64_t next = UINT64_MAX;
+    for (size_t level = 0; level < LEVELS; level++) {
+      uint64_t pos = (now_ >> levelShift(level)) & SLOT_MASK;
+      bitop::ull bits = occupied_[level] & slotsAfter(pos);
+      if (bits != 0) {
+        uint64_t base = (now_ >> levelShift(level + 1))
+                        << levelShift(level + 1);
+        uint64_t tick = base + (bitop::countrZero(bits) << levelShift(level));
+        next = mystd::min(next, tick);
+      }
+    }
+    if (heads_[OVERFLOW_BUCKET] != NIL) {
+      uint64_t tick = ((now_ >> levelShift(LEVELS)) + 1)
+                      << levelShift(LEVELS);
+      next = mystd::min(next, tick);
+    }
+    return next;
+  }
+
+public:
+  explicit TimerWheel(uint64_t start = 0)
+      : heads_(OVERFLOW_BUCKET + 1, NIL), now_(start) {}
+
+  [[nodiscard]] auto now() const -> uint64_t { return now_; }
+  [[nodiscard]] auto size() const -> size_t { return pending_; }
+  [[nodiscard]] auto empty() const -> bool { return pending_ == 0; }
+
+  // 不晚于当前时间的定时器视为在下一个 tick 到期
+  template <typename F>
+  auto schedule(uint64_t deadline, F &&callback) -> TimerHandle {
+    deadline = mystd::max(deadline, now_ + 1);
+    uint32_t idx;
+    if (free_head_ != NIL) {
+      idx = free_head_;
+      free_head_ = nodes_[idx].nxt_;
+      nodes_[idx].deadline_ = deadline;
+      nodes_[idx].callback_ = std::forward<F>(callback);
+    } else {
+      idx = static_cast<uint32_t>(nodes_.size());
+      nodes_.pushBack(Node{deadline, NIL, NIL, NIL, 0,
+                           Callback(std::forward<F>(callback))});
+    }
+    place(idx);
+    pending_++;
+    return TimerHandle{idx, nodes_[idx].generation_};
+  }
+
+  // 返回 false 表示定时器已经触发或已被取消
+  auto cancel(TimerHandle handle) -> bool {
+    if (handle.index_ >= nodes_.size()) {
+      return false;
+    }
+    Node &node = nodes_[handle.index_];
+    if (node.generation_ != handle.generation_ || node.bucket_ == NIL) {
+      return false;
+    }
+    unlink(handle.index_);
+    release(handle.index_);
+    pending_--;
+    return true;
+  }
+
+  // 推进到 now，触发所有到期时间不晚于 now 的定时器，返回触发的个数
+  // 同一 tick 内的定时器成批触发，不同 tick 之间按时间先后触发
+  auto advance(uint64_t now) -> size_t {
+    size_t fired = 0;
+    while (now_ < now) {
+      uint64_t next = pending_ == 0 ? UINT64_MAX : nextEventTick();
+      if (next > now) {
+        now_ = now;
+        break;
+      }
+      now_ = next;
+      // 先下放高层，使同一 tick 到期的定时器能一路落到第 0 层
+      if ((now_ & ((1ULL << levelShift(LEVELS)) - 1)) == 0) {
+        cascade(OVERFLOW_BUCKET);
+      }
+      for (size_t level = LEVELS - 1; level > 0; level--) {
+        if ((now_ & ((1ULL << levelShift(level)) - 1)) == 0) {
+          cascade(level * SLOTS + ((now_ >> levelShift(level)) & SLOT_MASK));
+        }
+      }
+      fired += fire(now_ & SLOT_MASK);
+    }
+    return fired;
+  }
+};
+
+}  // namespace mystd::timer_wheel
+
+#endif  // TIMERWHEEL_HPP
@@ -0,0 +1,154 @@
+#ifndef TOPK_HPP
+#define TOPK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "BitOperation.hpp"
+#include "Compare.hpp"
+#include "Vector.hpp"
+#include "common.h"
+
+namespace mystd::top_k {
+
+/// INFO: 流式维护前 K 大（按 Compare 意义，与 BinaryHeap 的大根堆保持一致）
+/// 内部是容量固定为 K 的小根堆，堆顶即当前阈值，不优于阈值的元素只需一次比较
+template <typename T, size_t K, typename Compare = mystd::compare::Less<T>>
+class TopK {
+  static_assert(K > 0, "TopK requires K > 0");
+
+private:
+  // 批量过滤时每块的元素个数，恰好对应一个 64 位掩码
+  static constexpr size_t BATCH_SIZE = 64;
+
+  vector::Vector<T> data_;
+  Compare comp_;
+
+  void siftUp(size_t idx) {
+    while (idx > 0) {
+      size_t parent = (idx - 1) / 2;
+      if (!comp_(data_[idx], data_[parent])) {
+        break;
+      }
+      mystd::swap(data_[parent], data_[idx]);
+      idx = parent;
+    }
+  }
+
+  void siftDown(size_t idx) {
+    size_t heap_size = data_.size();
+    while (true) {
+      size_t left = idx * 2 + 1;
+      size_t right = idx * 2 + 2;
+      size_t smallest = idx;
+
+      if (left < heap_size && comp_(data_[left], data_[smallest])) {
+        smallest = left;
+      }
+      if (right < heap_size && comp_(data_[right], data_[smallest])) {
+        smallest = right;
+      }
+      if (smallest == idx) {
+        break;
+      }
+      mystd::swap(data_[idx], data_[smallest]);
+      idx = smallest;
+    }
+  }
+
+public:
+  explicit TopK(const Compare &comp = Compare()) : data_(), comp_(comp) {
+    data_.reserve(K);
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return data_.empty(); }
+  [[nodiscard]] auto full() const -> bool { return data_.size() == K; }
+  [[nodiscard]] auto size() const -> size_t { return data_.size(); }
+  [[nodiscard]] static constexpr auto capacity() -> size_t { return K; }
+
+  // 当前保留元素中最差的一个，新元素必须严格优于它才会被接收
+  auto threshold() const -> const T & {
+    if (empty()) {
+      throw std::out_of_range("TopK::threshold on empty selector");
+    }
+    return data_[0];
+  }
+
+  // 返回值表示该元素是否被接收
+  template <typename U>
+  auto offer(U &&value) -> bool {
+    if (data_.size() < K) {
+      data_.pushBack(std::forward<U>(value));
+      siftUp(data_.size() - 1);
+      return true;
+    }
+    if (!comp_(data_[0], value)) {
+      return false;
+    }
+    data_[0] = std::forward<U>(value);
+    siftDown(0);
+    return true;
+  }
+
+  /// INFO: 批量接收 [first, last)，返回被接收的元素个数
+  /// 对随机访问迭代器，先用当前阈值对一整块生成无分支的掩码（便于向量化），
+  /// 再只对掩码中的候选逐个调用 offer；阈值只会变大，所以掩码是候选的超集
+  template <typename Iter>
+  auto offer(Iter first, Iter last) -> size_t {
+    using Category = typename std::iterator_traits<Iter>::iterator_category;
+    size_t accepted = 0;
+    while (first != last && data_.size() < K) {
+      offer(*first);
+      ++first;
+      accepted++;
+    }
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    Category>) {
+      while (last - first >= static_cast<ptrdiff_t>(BATCH_SIZE)) {
+        const T limit = data_[0];
+        bitop::ull mask = 0;
+        for (size_t i = 0; i < BATCH_SIZE; i++) {
+          mask |= static_cast<bitop::ull>(comp_(limit, first[i])) << i;
+        }
+        while (mask != 0) {
+          auto i = bitop::countrZero(mask);
+          accepted += static_cast<size_t>(offer(first[i]));
+          mask &= mask - 1;
+        }
+        first += BATCH_SIZE;
+      }
+    }
+    for (; first != last; ++first) {
+      accepted += static_cast<size_t>(offer(*first));
+    }
+    return accepted;
+  }
+
+  // 合并另一个（例如其他线程的）选择器，结果等价于对两者的输入整体求 TopK
+  // 与自身合并时 offer 会修改正在遍历的 data_，因此先复制一份
+  void mergeFrom(const TopK &other) {
+    if (&other == this) {
+      vector::Vector<T> snapshot(data_);
+      offer(snapshot.cbegin(), snapshot.cend());
+      return;
+    }
+    offer(other.data_.cbegin(), other.data_.cend());
+  }
+
+  void clear() { data_.clear(); }
+
+  // 按从优到劣的顺序返回当前保留的元素
+  [[nodiscard]] auto sorted() const -> vector::Vector<T> {
+    vector::Vector<T> result(data_);
+    std::sort(result.begin(), result.end(),
+              [this](const T &lhs, const T &rhs) { return comp_(rhs, lhs); });
+    return result;
+  }
+};
+
+}  // namespace mystd::top_k
+
+#endif  // TOPK_HPP
@@ -0,0 +1,224 @@
+#ifndef WAVELETMATRIX_HPP
+#define WAVELETMATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BitOperation.hpp"
+#include "Vector.hpp"
+
+namespace mystd::wavelet_matrix {
+
+/// INFO: 静态位向量，按 64 位字压缩存放，另存每个字之前 1 的个数，
+/// rank 为一次查表加一次 popcount，O(1)
+class BitVector {
+private:
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+  // ones_before_[w] 为第 w 个字之前 1 的个数，多存一项表示总数
+  std::vector<size_t> ones_before_;
+
+public:
+  BitVector() = default;
+  explicit BitVector(size_t size)
+      : size_(size), words_(size / 64 + 1, 0), ones_before_(size / 64 + 2, 0) {}
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+  void set(size_t pos) { words_[pos / 64] |= uint64_t{1} << (pos % 64); }
+  [[nodiscard]] auto get(size_t pos) const -> bool {
+    return ((words_[pos / 64] >> (pos % 64)) & 1U) != 0;
+  }
+  // 所有 set 完成之后调用一次
+  void build() {
+    for (size_t w = 0; w < words_.size(); w++) {
+      ones_before_[w + 1] = ones_before_[w] + bitop::popcount(words_[w]);
+    }
+  }
+  // [0, pos) 中 1 的个数
+  [[nodiscard]] auto rank1(size_t pos) const -> size_t {
+    uint64_t low = words_[pos / 64] & ((uint64_t{1} << (pos % 64)) - 1);
+    return ones_before_[pos / 64] + bitop::popcount(low);
+  }
+  [[nodiscard]] auto rank0(size_t pos) const -> size_t {
+    return pos - rank1(pos);
+  }
+};
+
+/// INFO: 整数序列上的小波矩阵，回答区间第 k 小、区间内小于 x 的个数、
+/// 区间内落在 [lo, hi) 的个数，均为 O(log σ)，σ 为值域的位宽
+/// 从最高位开始，每一层按当前位把序列稳定地分成 0 在前、1 在后两部分，
+/// 该层的位向量记录划分前每个位置的这一位；共 log σ 个位向量，
+/// 空间约为 n log σ 位
+/// 存的是每个值与最小值之差（在对应的无符号类型中计算），层数只取决于
+/// 值域的跨度 max - min，与符号和偏移无关
+template <typename T>
+class WaveletMatrix {
+  static_assert(std::is_integral_v<T>, "WaveletMatrix requires integral T");
+
+private:
+  using Key = std::make_unsigned_t<T>;
+
+  size_t arr_size_ = 0;
+  // 所有元素的最小值，键为 val - min_；序列为空时为 T{}
+  T min_{};
+  int levels_ = 0;
+  // bits_[i] 与 zeros_[i] 对应第 levels_ - 1 - i 位
+  std::vector<BitVector> bits_;
+  std::vector<size_t> zeros_;
+
+  // 要求 val >= min_；无符号减法对有符号数同样得到正确的差
+  auto toKey(T val) const -> Key {
+    return static_cast<Key>(static_cast<Key>(val) - static_cast<Key>(min_));
+  }
+  auto fromKey(Key key) const -> T {
+    return static_cast<T>(static_cast<Key>(static_cast<Key>(min_) + key));
+  }
+
+  template <typename Container>
+  void build(const Container &arr) {
+    arr_size_ = arr.size();
+    for (size_t i = 0; i < arr_size_; i++) {
+      min_ = i == 0 || arr[i] < min_ ? arr[i] : min_;
+    }
+    std::vector<Key> cur(arr_size_);
+    Key max_key = 0;
+    for (size_t i = 0; i < arr_size_; i++) {
+      cur[i] = toKey(arr[i]);
+      max_key = cur[i] > max_key ? cur[i] : max_key;
+    }
+    levels_ = static_cast<int>(bitop::bitWidth(max_key));
+    std::vector<Key> next(arr_size_);
+    for (int level = 0; level < levels_; level++) {
+      int bit = levels_ - 1 - level;
+      BitVector bits(arr_size_);
+      size_t zeros = 0;
+      for (size_t i = 0; i < arr_size_; i++) {
+        if (((cur[i] >> bit) & 1U) != 0) {
+          bits.set(i);
+        } else {
+          next[zeros++] = cur[i];
+        }
+      }
+      bits.build();
+      size_t ones = zeros;
+      for (size_t i = 0; i < arr_size_; i++) {
+        if (bits.get(i)) {
+          next[ones++] = cur[i];
+        }
+      }
+      bits_.push_back(std::move(bits));
+      zeros_.push_back(zeros);
+      cur.swap(next);
+    }
+  }
+  // 半开区间 [left, right) 中键小于 key 的个数
+  auto countLess(size_t left, size_t right, Key key) const -> size_t {
+    if (levels_ < static_cast<int>(sizeof(Key) * 8) && (key >> levels_) != 0) {
+      return right - left;
+    }
+    size_t result = 0;
+    for (int level = 0; level < levels_; level++) {
+      int bit = levels_ - 1 - level;
+      size_t left_zero = bits_[level].rank0(left);
+      size_t right_zero = bits_[level].rank0(right);
+      if (((key >> bit) & 1U) != 0) {
+        result += right_zero - left_zero;
+        left = zeros_[level] + (left - left_zero);
+        right = zeros_[level] + (right - right_zero);
+      } else {
+        left = left_zero;
+        right = right_zero;
+      }
+    }
+    return result;
+  }
+  void checkInterval(int64_t left_bound, int64_t right_bound,
+                     const char *msg) const {
+    if (left_bound < 0 || right_bound >= static_cast<int64_t>(arr_size_) ||
+        left_bound > right_bound) {
+      throw std::out_of_range(msg);
+    }
+  }
+
+public:
+  explicit WaveletMatrix(const std::vector<T> &arr) { build(arr); }
+  explicit WaveletMatrix(const vector::Vector<T> &arr) { build(arr); }
+
+  [[nodiscard]] auto size() const -> int64_t {
+    return static_cast<int64_t>(arr_size_);
+  }
+  // 位向量的层数
+  [[nodiscard]] auto levels() const -> int { return levels_; }
+
+  // 以下区间均为闭区间 [L, R]
+  auto access(int64_t ind) const -> T {
+    checkInterval(ind, ind, "WaveletMatrix::access index out of range");
+    auto pos = static_cast<size_t>(ind);
+    Key key = 0;
+    for (int level = 0; level < levels_; level++) {
+      if (bits_[level].get(pos)) {
+        key |= Key{1} << (levels_ - 1 - level);
+        pos = zeros_[level] + bits_[level].rank1(pos);
+      } else {
+        pos = bits_[level].rank0(pos);
+      }
+    }
+    return fromKey(key);
+  }
+  // [L, R] 中第 k 小的值，k 从 0 开始
+  auto kth(int64_t left_bound, int64_t right_bound, int64_t k) const -> T {
+    checkInterval(left_bound, right_bound,
+                  "WaveletMatrix::kth invalid interval");
+    if (k < 0 || k > right_bound - left_bound) {
+      throw std::out_of_range("WaveletMatrix::kth invalid k");
+    }
+    auto left = static_cast<size_t>(left_bound);
+    auto right = static_cast<size_t>(right_bound) + 1;
+    auto rest = static_cast<size_t>(k);
+    Key key = 0;
+    for (int level = 0; level < levels_; level++) {
+      size_t left_zero = bits_[level].rank0(left);
+      size_t right_zero = bits_[level].rank0(right);
+      if (rest < right_zero - left_zero) {
+        left = left_zero;
+        right = right_zero;
+      } else {
+        rest -= right_zero - left_zero;
+        key |= Key{1} << (levels_ - 1 - level);
+        left = zeros_[level] + (left - left_zero);
+        right = zeros_[level] + (right - right_zero);
+      }
+    }
+    return fromKey(key);
+  }
+  // [L, R] 中小于 val 的元素个数
+  auto rank(int64_t left_bound, int64_t right_bound, T val) const -> int64_t {
+    checkInterval(left_bound, right_bound,
+                  "WaveletMatrix::rank invalid interval");
+    // 不超过最小值时没有更小的元素，此时也无法转换成键
+    if (!(min_ < val)) {
+      return 0;
+    }
+    return static_cast<int64_t>(countLess(static_cast<size_t>(left_bound),
+                                          static_cast<size_t>(right_bound) + 1,
+                                          toKey(val)));
+  }
+  // [L, R] 中满足 lower <= x < upper 的元素个数
+  auto rangeFreq(int64_t left_bound, int64_t right_bound, T lower,
+                 T upper) const -> int64_t {
+    checkInterval(left_bound, right_bound,
+                  "WaveletMatrix::rangeFreq invalid interval");
+    if (!(lower < upper)) {
+      return 0;
+    }
+    return rank(left_bound, right_bound, upper) -
+           rank(left_bound, right_bound, lower);
+  }
+};
+}  // namespace mystd::wavelet_matrix
+
+#endif  // WAVELETMATRIX_HPP
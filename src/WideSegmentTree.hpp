@@ -0,0 +1,160 @@
+#ifndef WIDESEGMENTTREE_HPP
+#define WIDESEGMENTTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace mystd::segment_tree {
+
+/// INFO: 16 叉的静态求和线段树（S-tree 布局），支持单点加、前缀和与区间和
+/// 第 h 层（0 为最底层）第 k 个节点管辖 [k · 16^(h+1), (k+1) · 16^(h+1))，
+/// 节点的第 j 个槽存前 j 个子区间的和（不含第 j 个），因此前缀 [0, i) 的和
+/// 为每层一个槽的和，查询 O(log16 n) 次读取；单点加要给每层一个节点中
+/// 下标大于该位置的槽都加上 delta，这正好是一次 16 路的带掩码加法，
+/// 编译时开启 AVX2 时用向量指令完成，否则为普通循环
+/// 要求 T 为算术类型，区间和通过前缀和相减得到
+template <typename T>
+class WideSegmentTree {
+  static_assert(std::is_arithmetic_v<T>,
+                "WideSegmentTree requires an arithmetic type");
+
+public:
+  static constexpr int FANOUT = 16;
+
+private:
+  static constexpr int SHIFT = 4;  // log2(FANOUT)
+
+  // 每个节点从缓存行边界开始，32 位的 T 恰好占一个缓存行
+  struct alignas(64) Node {
+    T slot_[FANOUT];
+  };
+
+  int64_t arr_size_;
+  int height_;
+  // layers_[h] 为第 h 层的全部节点
+  std::vector<std::vector<Node>> layers_;
+
+  // slot_[j] += delta，对所有 j > digit
+  static void addAfter(Node &node, int digit, T delta) {
+#ifdef __AVX2__
+    if constexpr (std::is_integral_v<T> && sizeof(T) == 4) {
+      const __m256i pivot = _mm256_set1_epi32(digit);
+      const __m256i add = _mm256_set1_epi32(static_cast<int32_t>(delta));
+      for (int i = 0; i < FANOUT; i += 8) {
+        const __m256i lane = _mm256_setr_epi32(i, i + 1, i + 2, i + 3, i + 4,
+                                               i + 5, i + 6, i + 7);
+        auto *ptr = reinterpret_cast<__m256i *>(node.slot_ + i);
+        __m256i mask = _mm256_cmpgt_epi32(lane, pivot);
+        _mm256_store_si256(ptr, _mm256_add_epi32(_mm256_load_si256(ptr),
+                                                 _mm256_and_si256(mask, add)));
+      }
+      return;
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 8) {
+      const __m256i pivot = _mm256_set1_epi64x(digit);
+      const __m256i add = _mm256_set1_epi64x(static_cast<int64_t>(delta));
+      for (int i = 0; i < FANOUT; i += 4) {
+        const __m256i lane = _mm256_setr_epi64x(i, i + 1, i + 2, i + 3);
+        auto *ptr = reinterpret_cast<__m256i *>(node.slot_ + i);
+        __m256i mask = _mm256_cmpgt_epi64(lane, pivot);
+        _mm256_store_si256(ptr, _mm256_add_epi64(_mm256_load_si256(ptr),
+                                                 _mm256_and_si256(mask, add)));
+      }
+      return;
+    }
+#endif
+    // 无分支的写法，编译器通常也能自动向量化
+    for (int j = 0; j < FANOUT; j++) {
+      node.slot_[j] += j > digit ? delta : T{};
+    }
+  }
+  // 前缀 [0, ind) 的和，0 <= ind <= arr_size_
+  auto prefixBefore(int64_t ind) const -> T {
+    T result{};
+    for (int h = height_ - 1; h >= 0; h--) {
+      const Node &node = layers_[h][ind >> (SHIFT * (h + 1))];
+      result += node.slot_[(ind >> (SHIFT * h)) & (FANOUT - 1)];
+    }
+    return result;
+  }
+
+public:
+  explicit WideSegmentTree(int64_t arr_size)
+      : WideSegmentTree(std::vector<T>(arr_size, T{})) {}
+  // 数组下标从 0 开始，自底向上逐层建树，O(n)
+  explicit WideSegmentTree(const std::vector<T> &arr)
+      : arr_size_(static_cast<int64_t>(arr.size())), height_(1) {
+    // 最高层只有一个节点，且下标 n 也要落在其中（前缀 [0, n) 的查询）
+    while ((arr_size_ >> (SHIFT * height_)) != 0) {
+      height_++;
+    }
+    std::vector<T> child = arr;
+    for (int h = 0; h < height_; h++) {
+      size_t nodes = static_cast<size_t>(arr_size_ >> (SHIFT * (h + 1))) + 1;
+      child.resize(nodes * FANOUT, T{});
+      std::vector<Node> layer(nodes);
+      std::vector<T> totals(nodes);
+      for (size_t k = 0; k < nodes; k++) {
+        T sum{};
+        for (int j = 0; j < FANOUT; j++) {
+          layer[k].slot_[j] = sum;
+          sum += child[k * FANOUT + j];
+        }
+        totals[k] = sum;
+      }
+      layers_.push_back(std::move(layer));
+      child = std::move(totals);
+    }
+  }
+  [[nodiscard]] auto size() const -> int64_t { return arr_size_; }
+  // 层数，即一次查询读取的节点数
+  [[nodiscard]] auto height() const -> int { return height_; }
+
+  // a[ind] += val
+  void apply(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("WideSegmentTree::apply index out of range");
+    }
+    for (int h = 0; h < height_; h++) {
+      addAfter(layers_[h][ind >> (SHIFT * (h + 1))],
+               static_cast<int>((ind >> (SHIFT * h)) & (FANOUT - 1)), val);
+    }
+  }
+  void assign(int64_t ind, T val) {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("WideSegmentTree::assign index out of range");
+    }
+    apply(ind, val - query(ind));
+  }
+  // 前缀 [0, ind] 的和，ind 为 -1 时返回 0
+  auto prefix(int64_t ind) const -> T {
+    if (ind < -1 || ind >= arr_size_) {
+      throw std::out_of_range("WideSegmentTree::prefix index out of range");
+    }
+    return prefixBefore(ind + 1);
+  }
+  auto query(int64_t ind) const -> T {
+    if (ind < 0 || ind >= arr_size_) {
+      throw std::out_of_range("WideSegmentTree::query index out of range");
+    }
+    return prefixBefore(ind + 1) - prefixBefore(ind);
+  }
+  // 区间为闭区间 [L, R]
+  auto query(int64_t left_bound, int64_t right_bound) const -> T {
+    if (left_bound < 0 || right_bound >= arr_size_ ||
+        left_bound > right_bound) {
+      throw std::out_of_range("WideSegmentTree::query invalid interval");
+    }
+    return prefixBefore(right_bound + 1) - prefixBefore(left_bound);
+  }
+};
+}  // namespace mystd::segment_tree
+
+#endif  // WIDESEGMENTTREE_HPP
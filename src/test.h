@@ -3,6 +3,7 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdlib>
 #include <iostream>
 #include <random>
 #include <stdexcept>
@@ -141,6 +142,11 @@ public:
 };
 // NOLINTEND
 
+// 需要数 GB 内存的超大规模测试，只有设置了环境变量 MYSTD_LARGE_TESTS 才运行
+inline auto largeTestsEnabled() -> bool {
+  return std::getenv("MYSTD_LARGE_TESTS") != nullptr;
+}
+
 #include <map>
 #include <vector>
 
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "AtomicFenwickTree.hpp"
+#include "common.h"
+#include "test.h"
+
+using namespace mystd::fenwick_tree;
+
+static void test_single_thread() {
+  RandomGenerator gen;
+  const int arr_len = 1000;
+  const int query_times = 20000;
+  std::vector<long long> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(gen.uniform_int(-1000, 1000));
+  }
+  AtomicFenwickTree<long long> atomic_tree(arr);
+  ShardedFenwickTree<long long> sharded_tree(arr_len, 3);
+  for (int i = 0; i < arr_len; i++) {
+    sharded_tree.apply(static_cast<size_t>(i % 3), i, arr[i]);
+  }
+  EXPECT_THROW(atomic_tree.apply(arr_len, 1), std::out_of_range);
+  EXPECT_THROW(atomic_tree.query(2, 1), std::out_of_range);
+  EXPECT_THROW(sharded_tree.apply(3, 0, 1), std::out_of_range);
+  EXPECT_THROW(sharded_tree.query(-2), std::out_of_range);
+  EXPECT_THROW(ShardedFenwickTree<int>(10, 0), std::invalid_argument);
+  EXPECT_THROW(ShardedFenwickTree<int>(-1, 2), std::invalid_argument);
+  EXPECT_THROW(AtomicFenwickTree<int>(-1), std::invalid_argument);
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) mystd::swap(l, r);
+    if (gen.bernoulli(0.5)) {
+      long long val = gen.uniform_int(-1000, 1000);
+      atomic_tree.apply(l, val);
+      sharded_tree.apply(static_cast<size_t>(q % 3), l, val);
+      arr[l] += val;
+    } else {
+      long long ans = 0;
+      for (int i = l; i <= r; i++) {
+        ans += arr[i];
+      }
+      CHECK_EQ(ans, atomic_tree.query(l, r));
+      CHECK_EQ(ans, sharded_tree.query(l, r));
+    }
+  }
+}
+
+// 多个写线程同时修改，另一个线程同时读：所有增量非负，
+// 读到的总和应当单调不减且不超过最终结果；写完后与逐线程记录的结果一致
+template <typename Tree, typename Apply>
+void runConcurrent(Tree &tree, int writers, Apply apply) {
+  const int arr_len = tree.size();
+  const int updates = 20000;
+  std::vector<std::vector<uint64_t>> added(
+      writers, std::vector<uint64_t>(arr_len, 0));
+  std::atomic<bool> done{false};
+  bool monotonic = true;
+  uint64_t last_total = 0;
+  std::thread reader([&]() {
+    while (!done.load(std::memory_order_acquire)) {
+      uint64_t total = tree.query(arr_len - 1);
+      monotonic = monotonic && total >= last_total;
+      last_total = total;
+    }
+  });
+  std::vector<std::thread> workers;
+  for (int t = 0; t < writers; t++) {
+    workers.emplace_back([&, t]() {
+      uint64_t state = 88172645463325252ULL + static_cast<uint64_t>(t);
+      for (int i = 0; i < updates; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int ind = static_cast<int>(state % static_cast<uint64_t>(arr_len));
+        uint64_t val = (state >> 32) % 100;
+        apply(t, ind, val);
+        added[t][ind] += val;
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+  uint64_t prefix = 0;
+  bool matched = true;
+  for (int i = 0; i < arr_len; i++) {
+    for (int t = 0; t < writers; t++) {
+      prefix += added[t][i];
+    }
+    matched = matched && prefix == tree.query(i);
+  }
+  CHECK_EQ(true, monotonic);
+  CHECK_EQ(true, last_total <= prefix);
+  CHECK_EQ(true, matched);
+}
+
+static void test_concurrent() {
+  const int writers = 4;
+  AtomicFenwickTree<uint64_t> atomic_tree(777);
+  runConcurrent(atomic_tree, writers, [&](int, int ind, uint64_t val) {
+    atomic_tree.apply(ind, val);
+  });
+  ShardedFenwickTree<uint64_t> sharded_tree(777, writers);
+  runConcurrent(sharded_tree, writers, [&](int t, int ind, uint64_t val) {
+    sharded_tree.apply(static_cast<size_t>(t), ind, val);
+  });
+}
+
+// register tests
+MAKE_TEST(AtomicFenwickTree, SingleThread) { test_single_thread(); }
+MAKE_TEST(AtomicFenwickTree, Concurrent) { test_concurrent(); }
@@ -0,0 +1,62 @@
+#include "BitOperation.hpp"
+#include "test.h"
+
+using namespace mystd::bitop;
+
+static void test_bit_ceil() {
+  CHECK_EQ(1ULL, bitCeil(0));
+  CHECK_EQ(1ULL, bitCeil(1));
+  CHECK_EQ(8ULL, bitCeil(5));
+  CHECK_EQ(1ULL << 31, bitCeil((1ULL << 31) - 1));
+  CHECK_EQ(1ULL << 32, bitCeil((1ULL << 31) + 1));
+  CHECK_EQ(1ULL << 63, bitCeil((1ULL << 62) + 1));
+  // 超出 64 位
+  CHECK_EQ(0ULL, bitCeil((1ULL << 63) + 1));
+}
+
+static void test_countr_zero() {
+  CHECK_EQ(0ULL, countrZero(1));
+  CHECK_EQ(3ULL, countrZero(40));
+  CHECK_EQ(32ULL, countrZero(1ULL << 32));
+  CHECK_EQ(63ULL, countrZero(1ULL << 63));
+  CHECK_EQ(64ULL, countrZero(0));
+  CHECK_EQ(1ULL << 40, lowbit((1ULL << 40) | (1ULL << 50)));
+}
+
+static void test_bit_width() {
+  CHECK_EQ(0ULL, bitWidth(0));
+  CHECK_EQ(1ULL, bitWidth(1));
+  CHECK_EQ(3ULL, bitWidth(5));
+  CHECK_EQ(64ULL, bitWidth(~0ULL));
+  CHECK_EQ(0ULL, floorLog(1));
+  CHECK_EQ(2ULL, floorLog(7));
+  CHECK_EQ(3ULL, floorLog(8));
+  CHECK_EQ(63ULL, floorLog(1ULL << 63));
+  for (ull n = 1; n < 5000; n++) {
+    ull width = 0;
+    for (ull x = n; x != 0; x >>= 1) {
+      width++;
+    }
+    CHECK_EQ(width, bitWidth(n));
+    CHECK_EQ(width - 1, floorLog(n));
+  }
+}
+
+static void test_popcount() {
+  CHECK_EQ(0ULL, popcount(0));
+  CHECK_EQ(64ULL, popcount(~0ULL));
+  CHECK_EQ(2ULL, popcount((1ULL << 63) | 1ULL));
+  for (ull n = 0; n < 5000; n++) {
+    ull count = 0;
+    for (ull x = n; x != 0; x >>= 1) {
+      count += x & 1;
+    }
+    CHECK_EQ(count, popcount(n));
+  }
+}
+
+// register tests
+MAKE_TEST(BitOperation, BitCeil) { test_bit_ceil(); }
+MAKE_TEST(BitOperation, CountrZero) { test_countr_zero(); }
+MAKE_TEST(BitOperation, BitWidth) { test_bit_width(); }
+MAKE_TEST(BitOperation, Popcount) { test_popcount(); }
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "BlockedFenwickTree.hpp"
+#include "FenwickTree.hpp"
+#include "common.h"
+#include "test.h"
+
+using namespace mystd::fenwick_tree;
+
+// 与朴素数组对比；长度不是块大小的倍数，覆盖最后一个不满的块
+template <typename Group, size_t BLOCK = 0>
+void test_BlockedFenwickTree(const Group &grp) {
+  using T = typename Group::ValueType;
+  RandomGenerator gen;
+  const int arr_len = 1003;
+  const int query_times = 30000;
+  const int num_range = 100000;
+  std::vector<T> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(static_cast<T>(gen.uniform_int(0, num_range)));
+  }
+  BlockedFenwickTree<Group, BLOCK> tree(arr, grp);
+  std::vector<T> ref = arr;
+  EXPECT_THROW(tree.apply(arr_len, T()), std::out_of_range);
+  EXPECT_THROW(tree.query(-2), std::out_of_range);
+  EXPECT_THROW(tree.query(2, 1), std::out_of_range);
+  CHECK_EQ(grp.identity(), tree.query(-1));
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) mystd::swap(l, r);
+    if (gen.bernoulli(0.5)) {
+      auto val = static_cast<T>(gen.uniform_int(0, num_range));
+      tree.apply(l, val);
+      ref[l] = grp.op(ref[l], val);
+    } else {
+      T ans = grp.identity();
+      for (int i = l; i <= r; i++) {
+        ans = grp.op(ans, ref[i]);
+      }
+      CHECK_EQ(ans, tree.query(l, r));
+    }
+  }
+}
+
+// 二分结果与普通树状数组一致
+template <size_t BLOCK = 0>
+void test_BlockedFenwickTreeBound() {
+  RandomGenerator gen;
+  const int arr_len = 1000;
+  const int query_times = 20000;
+  std::vector<long long> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(gen.uniform_int(0, 3));
+  }
+  BasicFenwickTree<group::Sum<long long>> plain(arr);
+  BlockedFenwickTree<group::Sum<long long>, BLOCK> blocked(arr);
+  for (int q = 0; q < query_times; q++) {
+    if (gen.bernoulli(0.3)) {
+      int ind = gen.uniform_int(0, arr_len - 1);
+      long long val = gen.uniform_int(0, 3);
+      plain.apply(ind, val);
+      blocked.apply(ind, val);
+      continue;
+    }
+    long long target = gen.uniform_int(-1, 2 * arr_len * 3);
+    CHECK_EQ(plain.lowerBound(target), blocked.lowerBound(target));
+    CHECK_EQ(plain.upperBound(target), blocked.upperBound(target));
+  }
+  BlockedFenwickTree<group::Sum<int>> empty_tree(0);
+  CHECK_EQ(0, empty_tree.lowerBound(1));
+  CHECK_EQ(0, empty_tree.upperBound(1));
+}
+
+// 层数为 ceil(log_BLOCK n)，至少一层
+void test_BlockedFenwickTreeLevels() {
+  using Tree4 = BlockedFenwickTree<group::Sum<int>, 4>;
+  CHECK_EQ(1, Tree4(0).levels());
+  CHECK_EQ(1, Tree4(4).levels());
+  CHECK_EQ(2, Tree4(5).levels());
+  CHECK_EQ(5, Tree4(1003).levels());
+  EXPECT_THROW(BlockedFenwickTree<group::Sum<int>>(-1), std::invalid_argument);
+}
+
+// register tests
+MAKE_TEST(BlockedFenwickTree, SumGroup) {
+  test_BlockedFenwickTree(group::Sum<long long>());
+  test_BlockedFenwickTree<group::Sum<long long>, 4>(group::Sum<long long>());
+}
+MAKE_TEST(BlockedFenwickTree, XorGroup) {
+  test_BlockedFenwickTree(group::Xor<uint32_t>());
+}
+MAKE_TEST(BlockedFenwickTree, ModSumGroup) {
+  test_BlockedFenwickTree(group::ModSum(998244353));
+}
+MAKE_TEST(BlockedFenwickTree, Bound) {
+  test_BlockedFenwickTreeBound();
+  test_BlockedFenwickTreeBound<4>();
+}
+MAKE_TEST(BlockedFenwickTree, Levels) { test_BlockedFenwickTreeLevels(); }
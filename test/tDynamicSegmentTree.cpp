@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "DynamicSegmentTree.hpp"
+#include "test.h"
+
+using namespace mystd::segment_tree;
+
+namespace TestDynamicSegmentTree {
+// 区间加、区间求和，按 2^64 取模（无符号整数自然溢出）
+struct node {
+  uint64_t sum, size;
+};
+node op(node l, node r) { return node{l.sum + r.sum, l.size + r.size}; }
+node e() { return node{0, 0}; }
+node mapping(uint64_t add, node nd) {
+  return node{nd.sum + add * nd.size, nd.size};
+}
+uint64_t composition(uint64_t f, uint64_t g) { return f + g; }
+uint64_t id() { return 0; }
+}  // namespace TestDynamicSegmentTree
+using namespace TestDynamicSegmentTree;
+
+using Tree =
+    DynamicSegmentTree<node, op, e, uint64_t, mapping, composition, id>;
+
+// 范围较小时与暴力数组对比，包含负下标和单点赋值
+static void test_small() {
+  RandomGenerator gen;
+  const int64_t lo = -500;
+  const int64_t hi = 1003;
+  const int query_times = 20000;
+  Tree tree(lo, hi, node{7, 1});
+  std::vector<uint64_t> ref(hi - lo, 7);
+  EXPECT_THROW(Tree(5, 5), std::invalid_argument);
+  EXPECT_THROW(tree.apply(hi, 1), std::out_of_range);
+  EXPECT_THROW(tree.query(lo - 1), std::out_of_range);
+  EXPECT_THROW(tree.query(3, 2), std::out_of_range);
+  CHECK_EQ(uint64_t{7} * (hi - lo), tree.query(lo, hi - 1).sum);
+  for (int q = 0; q < query_times; q++) {
+    int64_t l = gen.uniform_int(lo, hi - 1);
+    int64_t r = gen.uniform_int(lo, hi - 1);
+    if (l > r) std::swap(l, r);
+    uint64_t val = gen.uniform_int(0, 1000);
+    switch (gen.uniform_int(0, 3)) {
+      case 0:
+        tree.apply(l, r, val);
+        for (int64_t i = l; i <= r; i++) {
+          ref[i - lo] += val;
+        }
+        break;
+      case 1:
+        tree.assign(l, node{val, 1});
+        ref[l - lo] = val;
+        break;
+      case 2:
+        CHECK_EQ(ref[l - lo], tree.query(l).sum);
+        break;
+      default: {
+        uint64_t ans = 0;
+        for (int64_t i = l; i <= r; i++) {
+          ans += ref[i - lo];
+        }
+        CHECK_EQ(ans, tree.query(l, r).sum);
+        CHECK_EQ(static_cast<uint64_t>(r - l + 1), tree.query(l, r).size);
+        break;
+      }
+    }
+  }
+}
+
+// 覆盖 2^63 宽的范围，只做区间加，答案按重叠长度直接计算
+static void test_huge() {
+  RandomGenerator gen;
+  const int64_t lo = -(int64_t{1} << 62);
+  const int64_t hi = int64_t{1} << 62;
+  const int query_times = 20000;
+  struct Add {
+    int64_t l, r;
+    uint64_t val;
+  };
+  Tree tree(lo, hi, node{1, 1});
+  std::vector<Add> adds;
+  auto overlap = [](int64_t l1, int64_t r1, int64_t l2, int64_t r2) {
+    int64_t l = l1 > l2 ? l1 : l2;
+    int64_t r = r1 < r2 ? r1 : r2;
+    return l > r ? uint64_t{0} : static_cast<uint64_t>(r - l) + 1;
+  };
+  for (int q = 0; q < query_times; q++) {
+    int64_t l = gen.uniform_int(lo, hi - 1);
+    int64_t r = gen.uniform_int(lo, hi - 1);
+    if (l > r) std::swap(l, r);
+    if (gen.bernoulli(0.5)) {
+      uint64_t val = gen.uniform_int(0, 1000);
+      tree.apply(l, r, val);
+      adds.push_back(Add{l, r, val});
+    } else if (!adds.empty() && q % 8 == 1) {
+      // 只检查最近修改的端点附近，避免参考实现的代价过高
+      const Add &last = adds.back();
+      uint64_t ans = overlap(last.l, last.r, last.l, last.l);
+      for (const Add &add : adds) {
+        ans += add.val * overlap(add.l, add.r, last.l, last.l);
+      }
+      CHECK_EQ(ans, tree.query(last.l).sum);
+    } else {
+      uint64_t ans = static_cast<uint64_t>(r - l) + 1;
+      for (const Add &add : adds) {
+        ans += add.val * overlap(add.l, add.r, l, r);
+      }
+      CHECK_EQ(ans, tree.query(l, r).sum);
+    }
+  }
+  // 每次区间修改最多在每层新建 4 个节点
+  CHECK_EQ(true, tree.nodeCount() <= adds.size() * 4 * 64 + 1);
+}
+
+// register tests
+MAKE_TEST(DynamicSegmentTree, Small) { test_small(); }
+MAKE_TEST(DynamicSegmentTree, Huge) { test_huge(); }
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 
@@ -65,5 +66,152 @@ void test_FenwickTree() {
   }
 }
 
+// 以群类型为参数的版本，与暴力结果对比
+template <typename Group>
+void test_BasicFenwickTree(const Group &grp) {
+  using T = typename Group::ValueType;
+  RandomGenerator gen;
+  const int arr_len = 2000;
+  const int query_times = 20000;
+  const int num_range = 1000000;
+  std::vector<T> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(static_cast<T>(gen.uniform_int(0, num_range)));
+  }
+  BasicFenwickTree<Group> tree(arr, grp);
+  std::vector<T> ref = arr;
+  CHECK_EQ(arr_len, tree.size());
+  EXPECT_THROW(tree.query(-2), std::out_of_range);
+  EXPECT_THROW(tree.query(1, 0), std::out_of_range);
+  EXPECT_THROW(tree.apply(arr_len, T()), std::out_of_range);
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) mystd::swap(l, r);
+    if (gen.bernoulli()) {
+      auto val = static_cast<T>(gen.uniform_int(0, num_range));
+      tree.apply(l, val);
+      ref[l] = grp.op(ref[l], val);
+    } else {
+      T ans = grp.identity();
+      for (int i = l; i <= r; i++) {
+        ans = grp.op(ans, ref[i]);
+      }
+      CHECK_EQ(ans, tree.query(l, r));
+    }
+  }
+}
+
+// 前缀和上的二分，与逐个累加的结果对比
+void test_FenwickTreeBound() {
+  RandomGenerator gen;
+  const int arr_len = 1000;
+  const int query_times = 20000;
+  std::vector<long long> arr;
+  for (int i = 0; i < arr_len; i++) {
+    // 含有 0，检验相等前缀和时两种二分的区别
+    arr.push_back(gen.uniform_int(0, 3));
+  }
+  BasicFenwickTree<group::Sum<long long>> tree(arr);
+  std::vector<long long> ref = arr;
+  for (int q = 0; q < query_times; q++) {
+    if (gen.bernoulli(0.3)) {
+      int ind = gen.uniform_int(0, arr_len - 1);
+      long long val = gen.uniform_int(0, 3);
+      tree.apply(ind, val);
+      ref[ind] += val;
+      continue;
+    }
+    long long target = gen.uniform_int(-1, 2 * arr_len * 3);
+    int lower = arr_len;
+    int upper = arr_len;
+    long long sum = 0;
+    for (int i = 0; i < arr_len; i++) {
+      sum += ref[i];
+      if (lower == arr_len && sum >= target) lower = i;
+      if (upper == arr_len && sum > target) upper = i;
+    }
+    CHECK_EQ(lower, tree.lowerBound(target));
+    CHECK_EQ(upper, tree.upperBound(target));
+  }
+  BasicFenwickTree<group::Sum<int>> empty_tree(0);
+  CHECK_EQ(0, empty_tree.lowerBound(1));
+  CHECK_EQ(0, empty_tree.upperBound(1));
+}
+
+// 从空树开始交替追加、修改和查询，与朴素数组对比
+void test_FenwickTreePushBack() {
+  RandomGenerator gen;
+  const int query_times = 30000;
+  BasicFenwickTree<group::Sum<long long>> tree(0);
+  tree.reserve(100);
+  CHECK_EQ(true, tree.capacity() >= 100);
+  CHECK_EQ(0, tree.size());
+  EXPECT_THROW(BasicFenwickTree<group::Sum<long long>>(-1),
+               std::invalid_argument);
+  std::vector<long long> ref;
+  for (int q = 0; q < query_times; q++) {
+    int opt = ref.empty() ? 0 : gen.uniform_int(0, 2);
+    long long val = gen.uniform_int(-1000, 1000);
+    if (opt == 0) {
+      tree.pushBack(val);
+      ref.push_back(val);
+      CHECK_EQ(static_cast<int>(ref.size()), tree.size());
+      continue;
+    }
+    int l = gen.uniform_int(0, static_cast<int>(ref.size()) - 1);
+    int r = gen.uniform_int(0, static_cast<int>(ref.size()) - 1);
+    if (l > r) mystd::swap(l, r);
+    if (opt == 1) {
+      tree.apply(l, val);
+      ref[l] += val;
+    } else {
+      long long ans = 0;
+      for (int i = l; i <= r; i++) {
+        ans += ref[i];
+      }
+      CHECK_EQ(ans, tree.query(l, r));
+    }
+  }
+  EXPECT_THROW(tree.apply(tree.size(), 1), std::out_of_range);
+}
+
+// 下标超过 2^31 的情形，约需 2 GiB 内存
+void test_FenwickTreeLarge() {
+  BasicFenwickTree<group::Sum<uint8_t>> small(10);
+  EXPECT_THROW(small.query(int64_t{1} << 32), std::out_of_range);
+  if (!largeTestsEnabled()) {
+    return;
+  }
+  const int64_t base = int64_t{1} << 31;
+  const int64_t arr_len = base + 1000;
+  BasicFenwickTree<group::Sum<uint8_t>> tree(arr_len);
+  CHECK_EQ(arr_len, tree.size());
+  tree.apply(5, 1);
+  tree.apply(base + 3, 2);
+  tree.apply(arr_len - 1, 3);
+  CHECK_EQ(uint8_t{1}, tree.query(base + 2));
+  CHECK_EQ(uint8_t{3}, tree.query(base + 3));
+  CHECK_EQ(uint8_t{6}, tree.query(arr_len - 1));
+  CHECK_EQ(uint8_t{3}, tree.query(base + 4, arr_len - 1));
+  CHECK_EQ(base + 3, tree.lowerBound(3));
+  CHECK_EQ(arr_len - 1, tree.upperBound(3));
+  tree.pushBack(4);
+  CHECK_EQ(uint8_t{10}, tree.query(arr_len));
+}
+
 // register tests
-MAKE_TEST(FenwickTree, Default) { test_FenwickTree(); }
\ No newline at end of file
+MAKE_TEST(FenwickTree, Default) { test_FenwickTree(); }
+MAKE_TEST(FenwickTree, Large) { test_FenwickTreeLarge(); }
+MAKE_TEST(FenwickTree, Bound) { test_FenwickTreeBound(); }
+MAKE_TEST(FenwickTree, PushBack) { test_FenwickTreePushBack(); }
+MAKE_TEST(FenwickTree, SumGroup) {
+  test_BasicFenwickTree(group::Sum<long long>());
+}
+MAKE_TEST(FenwickTree, XorGroup) {
+  test_BasicFenwickTree(group::Xor<uint32_t>());
+}
+MAKE_TEST(FenwickTree, ModSumGroup) {
+  test_BasicFenwickTree(group::ModSum(998244353));
+  test_BasicFenwickTree(group::ModSum(1000003));
+}
\ No newline at end of file
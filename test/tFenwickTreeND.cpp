@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "FenwickTree.hpp"
+#include "FenwickTreeND.hpp"
+#include "common.h"
+#include "test.h"
+
+using namespace mystd::fenwick_tree;
+
+void test_FenwickTree2D() {
+  RandomGenerator gen;
+  const int rows = 60;
+  const int cols = 45;
+  const int query_times = 20000;
+  const int num_range = 1000;
+  std::vector<long long> values;
+  for (int i = 0; i < rows * cols; i++) {
+    values.push_back(gen.uniform_int(-num_range, num_range));
+  }
+  FenwickTree2D<group::Sum<long long>> tree({rows, cols}, values);
+  std::vector<long long> ref = values;
+  EXPECT_THROW(tree.apply(rows, 0, 1), std::out_of_range);
+  EXPECT_THROW(tree.query(0, 0, 0, cols), std::out_of_range);
+  EXPECT_THROW(tree.query(1, 0, 0, 0), std::out_of_range);
+  EXPECT_THROW(FenwickTree2D<group::Sum<long long>>({2, 2}, values),
+               std::invalid_argument);
+  CHECK_EQ(0LL, tree.query({-1, cols - 1}));
+  for (int q = 0; q < query_times; q++) {
+    int x1 = gen.uniform_int(0, rows - 1);
+    int x2 = gen.uniform_int(0, rows - 1);
+    int y1 = gen.uniform_int(0, cols - 1);
+    int y2 = gen.uniform_int(0, cols - 1);
+    if (x1 > x2) mystd::swap(x1, x2);
+    if (y1 > y2) mystd::swap(y1, y2);
+    if (gen.bernoulli()) {
+      long long val = gen.uniform_int(-num_range, num_range);
+      tree.apply(x1, y1, val);
+      ref[x1 * cols + y1] += val;
+    } else {
+      long long ans = 0;
+      for (int i = x1; i <= x2; i++) {
+        for (int j = y1; j <= y2; j++) {
+          ans += ref[i * cols + j];
+        }
+      }
+      CHECK_EQ(ans, tree.query(x1, y1, x2, y2));
+    }
+  }
+}
+
+void test_FenwickTree3D() {
+  RandomGenerator gen;
+  using Tree = FenwickTreeND<group::Xor<unsigned>, 3>;
+  const Tree::Index dims{7, 5, 9};
+  const int query_times = 5000;
+  Tree tree(dims);
+  std::vector<unsigned> ref(dims[0] * dims[1] * dims[2], 0);
+  auto at = [&](int64_t x, int64_t y, int64_t z) -> unsigned & {
+    return ref[(x * dims[1] + y) * dims[2] + z];
+  };
+  for (int q = 0; q < query_times; q++) {
+    Tree::Index lo{};
+    Tree::Index hi{};
+    for (int d = 0; d < 3; d++) {
+      lo[d] = gen.uniform_int(0, dims[d] - 1);
+      hi[d] = gen.uniform_int(0, dims[d] - 1);
+      if (lo[d] > hi[d]) mystd::swap(lo[d], hi[d]);
+    }
+    if (gen.bernoulli()) {
+      auto val = static_cast<unsigned>(gen.uniform_int(0, 1 << 20));
+      tree.apply(lo, val);
+      at(lo[0], lo[1], lo[2]) ^= val;
+    } else {
+      unsigned ans = 0;
+      for (int64_t x = lo[0]; x <= hi[0]; x++) {
+        for (int64_t y = lo[1]; y <= hi[1]; y++) {
+          for (int64_t z = lo[2]; z <= hi[2]; z++) {
+            ans ^= at(x, y, z);
+          }
+        }
+      }
+      CHECK_EQ(ans, tree.query(lo, hi));
+    }
+  }
+}
+
+// register tests
+MAKE_TEST(FenwickTreeND, TwoDimensional) { test_FenwickTree2D(); }
+MAKE_TEST(FenwickTreeND, ThreeDimensional) { test_FenwickTree3D(); }
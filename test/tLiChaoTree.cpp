@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Compare.hpp"
+#include "LiChaoTree.hpp"
+#include "test.h"
+
+using namespace mystd::segment_tree;
+
+namespace TestLiChaoTree {
+// 暴力维护所有线段，线段的区间为闭区间
+struct Segment {
+  int64_t left, right;
+  Line<int64_t> line;
+};
+
+template <typename Compare>
+auto bruteQuery(const std::vector<Segment> &segs, int64_t pos, int64_t init)
+    -> int64_t {
+  Compare comp;
+  int64_t result = init;
+  for (const auto &seg : segs) {
+    if (seg.left <= pos && pos <= seg.right) {
+      int64_t val = seg.line.eval(pos);
+      result = comp(val, result) ? val : result;
+    }
+  }
+  return result;
+}
+
+// 直线与线段交替插入，每次插入后随机查询
+template <typename Tree, typename Compare>
+void runRandom(int64_t lo, int64_t hi, int64_t max_slope, int64_t init) {
+  RandomGenerator gen;
+  const int insert_times = 500;
+  const int query_per_insert = 10;
+  Tree tree(lo, hi, init);
+  std::vector<Segment> segs;
+  CHECK_EQ(init, tree.query(lo));
+  CHECK_EQ(init, tree.query(hi - 1));
+  EXPECT_THROW(tree.query(hi), std::out_of_range);
+  EXPECT_THROW(tree.addSegment(lo, hi, Line<int64_t>{0, 0}),
+               std::out_of_range);
+  for (int i = 0; i < insert_times; i++) {
+    Line<int64_t> line{gen.uniform_int(-max_slope, max_slope),
+                       gen.uniform_int(int64_t{-1000000}, int64_t{1000000})};
+    if (gen.bernoulli(0.3)) {
+      tree.addLine(line);
+      segs.push_back(Segment{lo, hi - 1, line});
+    } else {
+      int64_t l = gen.uniform_int(lo, hi - 1);
+      int64_t r = gen.uniform_int(lo, hi - 1);
+      if (l > r) std::swap(l, r);
+      tree.addSegment(l, r, line);
+      segs.push_back(Segment{l, r, line});
+    }
+    for (int q = 0; q < query_per_insert; q++) {
+      int64_t pos = gen.uniform_int(lo, hi - 1);
+      CHECK_EQ(bruteQuery<Compare>(segs, pos, init), tree.query(pos));
+    }
+  }
+}
+}  // namespace TestLiChaoTree
+using namespace TestLiChaoTree;
+
+using mystd::compare::Greater;
+using mystd::compare::Less;
+
+// register tests
+MAKE_TEST(LiChaoTree, Dense) {
+  runRandom<LiChaoTree<int64_t>, Less<int64_t>>(-500, 1003, 1000, INT64_MAX);
+  runRandom<LiChaoTree<int64_t, Greater<int64_t>>, Greater<int64_t>>(
+      0, 1, 1000, INT64_MIN);
+  runRandom<LiChaoTree<int64_t, Greater<int64_t>>, Greater<int64_t>>(
+      7, 4096, 1000, INT64_MIN);
+  EXPECT_THROW(LiChaoTree<int64_t>(3, 3, 0), std::invalid_argument);
+  EXPECT_THROW(LiChaoTree<int64_t>(INT64_MIN, INT64_MAX, 0), std::length_error);
+  EXPECT_THROW(LiChaoTree<int64_t>(-1, int64_t{1} << 62, 0), std::length_error);
+}
+MAKE_TEST(LiChaoTree, Dynamic) {
+  const int64_t range = 1000000000000;
+  runRandom<DynamicLiChaoTree<int64_t>, Less<int64_t>>(-range, range, 1000000,
+                                                       INT64_MAX);
+  runRandom<DynamicLiChaoTree<int64_t, Greater<int64_t>>, Greater<int64_t>>(
+      -500, 1003, 1000, INT64_MIN);
+  // 整个 int64_t 范围，斜率为 0 时不会溢出
+  DynamicLiChaoTree<int64_t> full(INT64_MIN, INT64_MAX, 0);
+  full.addLine(Line<int64_t>{0, -5});
+  full.addSegment(INT64_MIN, -1, Line<int64_t>{0, -7});
+  CHECK_EQ(int64_t{-7}, full.query(INT64_MIN));
+  CHECK_EQ(int64_t{-5}, full.query(INT64_MAX - 1));
+  CHECK_EQ(int64_t{-5}, full.query(0));
+  EXPECT_THROW(DynamicLiChaoTree<int64_t>(3, 2, 0), std::invalid_argument);
+}
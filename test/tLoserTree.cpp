@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Compare.hpp"
+#include "LoserTree.hpp"
+#include "Vector.hpp"
+#include "test.h"
+
+using namespace mystd::loser_tree;
+using mystd::vector::Vector;
+
+using Iter = std::vector<int>::const_iterator;
+
+static void test_merge_random() {
+  RandomGenerator gen;
+  for (int k : {1, 2, 3, 7, 16, 33}) {
+    std::vector<std::vector<int>> runs(k);
+    std::vector<int> ref;
+    for (auto &run : runs) {
+      int len = gen.uniform_int(0, 500);
+      for (int i = 0; i < len; i++) {
+        run.push_back(gen.uniform_int(0, 1000));
+      }
+      std::sort(run.begin(), run.end());
+      ref.insert(ref.end(), run.begin(), run.end());
+    }
+    std::sort(ref.begin(), ref.end());
+
+    Vector<std::pair<Iter, Iter>> ranges;
+    for (const auto &run : runs) {
+      ranges.pushBack(std::make_pair(run.cbegin(), run.cend()));
+    }
+    KWayMerger<Iter> merger(ranges);
+    std::vector<int> out;
+    for (int val : merger) {
+      out.push_back(val);
+    }
+    CHECK_EQ(ref, out);
+    CHECK_EQ(true, merger.empty());
+    EXPECT_THROW(merger.top(), std::out_of_range);
+    EXPECT_THROW(merger.pop(), std::out_of_range);
+  }
+}
+
+static void test_merge_stable() {
+  // 相等元素按输入区间编号输出
+  std::vector<int> run0{1, 2, 2};
+  std::vector<int> run1{2, 3};
+  std::vector<int> run2{};
+  std::vector<int> run3{0, 2};
+  KWayMerger<Iter> merger({{run0.cbegin(), run0.cend()},
+                           {run1.cbegin(), run1.cend()},
+                           {run2.cbegin(), run2.cend()},
+                           {run3.cbegin(), run3.cend()}});
+  std::vector<std::pair<int, size_t>> out;
+  while (!merger.empty()) {
+    out.emplace_back(merger.top(), merger.topRun());
+    merger.pop();
+  }
+  std::vector<std::pair<int, size_t>> ref{{0, 3}, {1, 0}, {2, 0}, {2, 0},
+                                          {2, 1}, {2, 3}, {3, 1}};
+  CHECK_EQ(true, ref == out);
+
+  std::vector<int> desc0{9, 5, 1};
+  std::vector<int> desc1{8, 7};
+  KWayMerger<Iter, mystd::compare::Greater<int>> rev(
+      {{desc0.cbegin(), desc0.cend()}, {desc1.cbegin(), desc1.cend()}});
+  std::vector<int> rev_out(rev.begin(), rev.end());
+  CHECK_EQ((std::vector<int>{9, 8, 7, 5, 1}), rev_out);
+
+  KWayMerger<Iter> none(Vector<std::pair<Iter, Iter>>{});
+  CHECK_EQ(true, none.empty());
+  CHECK_EQ(true, none.begin() == none.end());
+}
+
+static void test_loser_tree_replace_top() {
+  // 用 replaceTop 模拟外部排序：每个槽位由调用方逐个喂入
+  RandomGenerator gen;
+  const int k = 10;
+  std::vector<std::vector<int>> runs(k);
+  std::vector<int> ref;
+  for (auto &run : runs) {
+    int len = gen.uniform_int(1, 300);
+    for (int i = 0; i < len; i++) {
+      run.push_back(gen.uniform_int(-1000, 1000));
+    }
+    std::sort(run.begin(), run.end());
+    ref.insert(ref.end(), run.begin(), run.end());
+  }
+  std::sort(ref.begin(), ref.end());
+
+  Vector<int> init;
+  std::vector<size_t> pos(k, 1);
+  for (const auto &run : runs) {
+    init.pushBack(run[0]);
+  }
+  LoserTree<int> tree(init);
+  CHECK_EQ(static_cast<size_t>(k), tree.size());
+  std::vector<int> out;
+  while (!tree.empty()) {
+    out.push_back(tree.top());
+    size_t slot = tree.topIndex();
+    if (pos[slot] < runs[slot].size()) {
+      tree.replaceTop(runs[slot][pos[slot]++]);
+    } else {
+      tree.retireTop();
+    }
+  }
+  CHECK_EQ(ref, out);
+  EXPECT_THROW(tree.top(), std::out_of_range);
+  EXPECT_THROW(tree.replaceTop(1), std::out_of_range);
+  EXPECT_THROW(tree.retireTop(), std::out_of_range);
+}
+
+// register tests
+MAKE_TEST(LoserTree, MergeRandom) { test_merge_random(); }
+MAKE_TEST(LoserTree, MergeStable) { test_merge_stable(); }
+MAKE_TEST(LoserTree, ReplaceTop) { test_loser_tree_replace_top(); }
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Compare.hpp"
+#include "MultiQueue.hpp"
+#include "test.h"
+
+using namespace mystd::multi_queue;
+
+static void test_single_shard_is_strict() {
+  // 只有一个分片时退化为严格的优先队列
+  MultiQueue<int> queue(1, 1);
+  CHECK_EQ(1u, queue.shardCount());
+  int out = 0;
+  CHECK_EQ(false, queue.tryPop(out));
+  for (int x : {5, 1, 4, 2, 3}) {
+    queue.push(x);
+  }
+  CHECK_EQ(5u, queue.size());
+  std::vector<int> popped;
+  while (queue.tryPop(out)) {
+    popped.push_back(out);
+  }
+  CHECK_EQ((std::vector<int>{5, 4, 3, 2, 1}), popped);
+  CHECK_EQ(true, queue.empty());
+  EXPECT_THROW(MultiQueue<int>(0), std::invalid_argument);
+}
+
+static void test_relaxed_order() {
+  // 多分片单线程：所有元素都能取出，且整体大致有序
+  MultiQueue<int, mystd::compare::Greater<int>> queue(4, 2, 2);
+  const int count = 20000;
+  for (int i = 0; i < count; i++) {
+    queue.push((i * 7919) % count);
+  }
+  std::vector<int> popped;
+  int out = 0;
+  while (queue.tryPop(out)) {
+    popped.push_back(out);
+  }
+  CHECK_EQ(static_cast<size_t>(count), popped.size());
+  long long displacement = 0;
+  for (int i = 0; i < count; i++) {
+    displacement += std::abs(popped[i] - i);
+  }
+  // 平均位移应当远小于元素个数
+  CHECK_EQ(true, displacement / count < count / 20);
+  std::sort(popped.begin(), popped.end());
+  for (int i = 0; i < count; i++) {
+    CHECK_EQ(i, popped[i]);
+  }
+}
+
+static void test_concurrent() {
+  const int threads = 4;
+  const int per_thread = 20000;
+  MultiQueue<int> queue(threads);
+  std::vector<std::vector<int>> popped(threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t]() {
+      int out = 0;
+      for (int i = 0; i < per_thread; i++) {
+        queue.push(t * per_thread + i);
+        if (i % 2 == 1 && queue.tryPop(out)) {
+          popped[t].push_back(out);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  std::vector<int> all;
+  for (auto &part : popped) {
+    all.insert(all.end(), part.begin(), part.end());
+  }
+  int out = 0;
+  while (queue.tryPop(out)) {
+    all.push_back(out);
+  }
+  CHECK_EQ(static_cast<size_t>(threads * per_thread), all.size());
+  std::sort(all.begin(), all.end());
+  for (int i = 0; i < threads * per_thread; i++) {
+    CHECK_EQ(i, all[i]);
+  }
+}
+
+// register tests
+MAKE_TEST(MultiQueue, SingleShard) { test_single_shard_is_strict(); }
+MAKE_TEST(MultiQueue, RelaxedOrder) { test_relaxed_order(); }
+MAKE_TEST(MultiQueue, Concurrent) { test_concurrent(); }
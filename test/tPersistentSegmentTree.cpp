@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "PersistentSegmentTree.hpp"
+#include "test.h"
+
+using namespace mystd::segment_tree;
+
+namespace TestPersistentSegmentTree {
+const long long mod = 1e9 + 7;
+// 区间修改 x <- x * a + b、区间求和，单点赋值，答案对 mod 取模
+struct node {
+  long long a;
+  int size;
+};
+struct func {
+  long long a, b;
+};
+node op(node l, node r) { return node{(l.a + r.a) % mod, l.size + r.size}; }
+node e() { return node{0, 0}; }
+node mapping(func fn, node nd) {
+  return node{(nd.a * fn.a % mod + nd.size * fn.b % mod) % mod, nd.size};
+}
+func composition(func new_fn, func old_fn) {
+  return func{new_fn.a * old_fn.a % mod,
+              (new_fn.a * old_fn.b % mod + new_fn.b) % mod};
+}
+func id() { return func{1, 0}; }
+}  // namespace TestPersistentSegmentTree
+using namespace TestPersistentSegmentTree;
+
+using Tree = PersistentSegmentTree<node, op, e, func, mapping, composition, id>;
+
+// 每个版本都保留一份暴力数组，在任意历史版本上修改和查询
+static void test_versions() {
+  RandomGenerator gen;
+  const int arr_len = 300;
+  const int op_times = 3000;
+  const int num_range = 100000;
+  std::vector<node> init;
+  std::vector<std::vector<long long>> refs(1);
+  for (int i = 0; i < arr_len; i++) {
+    long long val = gen.uniform_int(0, num_range);
+    init.push_back(node{val, 1});
+    refs[0].push_back(val);
+  }
+  Tree tree(init);
+  EXPECT_THROW(Tree(0), std::invalid_argument);
+  EXPECT_THROW(tree.query(1, 0), std::out_of_range);
+  EXPECT_THROW(tree.apply(0, 5, 4, func{1, 0}), std::out_of_range);
+  for (int q = 0; q < op_times; q++) {
+    int version = gen.uniform_int(0, tree.versionCount() - 1);
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    const std::vector<long long> &base = refs[version];
+    switch (gen.uniform_int(0, 2)) {
+      case 0: {
+        func f{gen.uniform_int(0, num_range), gen.uniform_int(0, num_range)};
+        std::vector<long long> next = base;
+        for (int i = l; i <= r; i++) {
+          next[i] = (next[i] * f.a % mod + f.b) % mod;
+        }
+        int expected = tree.versionCount();
+        CHECK_EQ(expected, tree.apply(version, l, r, f));
+        refs.push_back(std::move(next));
+        break;
+      }
+      case 1: {
+        long long val = gen.uniform_int(0, num_range);
+        std::vector<long long> next = base;
+        next[l] = val;
+        int expected = tree.versionCount();
+        CHECK_EQ(expected, tree.assign(version, l, node{val, 1}));
+        refs.push_back(std::move(next));
+        break;
+      }
+      default: {
+        long long ans = 0;
+        for (int i = l; i <= r; i++) {
+          ans = (ans + base[i]) % mod;
+        }
+        CHECK_EQ(ans, tree.query(version, l, r).a);
+        CHECK_EQ(base[r], tree.query(version, r).a);
+        break;
+      }
+    }
+  }
+  // 每次修改只新建 O(log n) 个节点
+  CHECK_EQ(true, tree.nodeCount() <=
+                     2 * arr_len + static_cast<size_t>(op_times) * 4 * 10);
+}
+
+static void test_rollback_and_drop() {
+  const int arr_len = 64;
+  Tree tree(std::vector<node>(arr_len, node{1, 1}));
+  int v1 = tree.apply(0, 0, arr_len - 1, func{2, 0});
+  size_t nodes_v1 = tree.nodeCount();
+  int v2 = tree.apply(v1, 10, 20, func{1, 5});
+  int v3 = tree.assign(v2, 15, node{100, 1});
+  CHECK_EQ(2LL * arr_len + 11 * 5 + 100 - 7, tree.query(v3, 0, arr_len - 1).a);
+
+  // 回滚到 v1，之后的版本与节点都被丢弃
+  tree.rollback(v1);
+  CHECK_EQ(v1 + 1, tree.versionCount());
+  CHECK_EQ(nodes_v1, tree.nodeCount());
+  EXPECT_THROW(tree.query(v2, 0), std::out_of_range);
+  CHECK_EQ(2LL * arr_len, tree.query(v1, 0, arr_len - 1).a);
+
+  // 丢弃 v1 之前的版本，版本号不变
+  int v4 = tree.apply(v1, 0, 0, func{1, 1});
+  size_t before = tree.nodeCount();
+  tree.dropBefore(v1);
+  CHECK_EQ(v1, tree.firstVersion());
+  CHECK_EQ(true, tree.nodeCount() < before);
+  EXPECT_THROW(tree.query(0, 0), std::out_of_range);
+  CHECK_EQ(2LL * arr_len, tree.query(v1, 0, arr_len - 1).a);
+  CHECK_EQ(2LL * arr_len + 1, tree.query(v4, 0, arr_len - 1).a);
+  CHECK_EQ(3LL, tree.query(v4, 0).a);
+  // 搬运后的 arena 仍可以回滚
+  int v5 = tree.assign(v4, 1, node{0, 1});
+  CHECK_EQ(2LL * arr_len - 1, tree.query(v5, 0, arr_len - 1).a);
+  tree.rollback(v4);
+  EXPECT_THROW(tree.query(v5, 0), std::out_of_range);
+  CHECK_EQ(2LL * arr_len + 1, tree.query(v4, 0, arr_len - 1).a);
+}
+
+// register tests
+MAKE_TEST(PersistentSegmentTree, Versions) { test_versions(); }
+MAKE_TEST(PersistentSegmentTree, RollbackAndDrop) { test_rollback_and_drop(); }
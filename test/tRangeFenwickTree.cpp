@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "FenwickTree.hpp"
+#include "RangeFenwickTree.hpp"
+#include "common.h"
+#include "test.h"
+
+using namespace mystd::fenwick_tree;
+
+namespace TestRangeFenwickTree {
+const long long mod = 1e9 + 7;
+long long e() { return 0; }
+long long add(long long x, long long y) { return (x + y) % mod; }
+long long sub(long long x, long long y) { return ((x - y) % mod + mod) % mod; }
+}  // namespace TestRangeFenwickTree
+
+template <typename Group>
+void test_RangeFenwickTree(const Group &grp) {
+  using T = typename Group::ValueType;
+  RandomGenerator gen;
+  const int arr_len = 3000;
+  const int query_times = 30000;
+  const int num_range = 100000;
+  std::vector<T> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(static_cast<T>(gen.uniform_int(0, num_range)));
+  }
+  RangeFenwickTree<Group> tree(arr, grp);
+  std::vector<T> ref = arr;
+  EXPECT_THROW(tree.apply(-1, 1, T()), std::out_of_range);
+  EXPECT_THROW(tree.apply(2, 1, T()), std::out_of_range);
+  EXPECT_THROW(tree.apply(arr_len, T()), std::out_of_range);
+  EXPECT_THROW(tree.query(0, arr_len), std::out_of_range);
+  EXPECT_THROW(tree.query(-1), std::out_of_range);
+  EXPECT_THROW(RangeFenwickTree<Group>(-1, grp), std::invalid_argument);
+  const RangeFenwickTree<Group> blank(5, grp);
+  CHECK_EQ(grp.identity(), blank.query(0, 4));
+  for (int q = 0; q < query_times; q++) {
+    int opt = gen.uniform_int(0, 3);
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) mystd::swap(l, r);
+    auto val = static_cast<T>(gen.uniform_int(0, num_range));
+    switch (opt) {
+      case 0: {
+        tree.apply(l, r, val);
+        for (int i = l; i <= r; i++) {
+          ref[i] = grp.op(ref[i], val);
+        }
+        break;
+      }
+      case 1: {
+        tree.apply(l, val);
+        ref[l] = grp.op(ref[l], val);
+        break;
+      }
+      case 2: {
+        CHECK_EQ(ref[l], tree.query(l));
+        break;
+      }
+      case 3: {
+        T ans = grp.identity();
+        for (int i = l; i <= r; i++) {
+          ans = grp.op(ans, ref[i]);
+        }
+        CHECK_EQ(ans, tree.query(l, r));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+// register tests
+MAKE_TEST(RangeFenwickTree, Sum) {
+  test_RangeFenwickTree(group::Sum<long long>());
+}
+MAKE_TEST(RangeFenwickTree, Xor) {
+  test_RangeFenwickTree(group::Xor<uint32_t>());
+}
+MAKE_TEST(RangeFenwickTree, ModSum) {
+  test_RangeFenwickTree(group::ModSum(998244353));
+}
+// 函数指针形式的群没有 times，走倍增
+MAKE_TEST(RangeFenwickTree, FunctionGroup) {
+  using namespace TestRangeFenwickTree;
+  test_RangeFenwickTree(group::FunctionGroup<long long, e, add, sub>());
+}
@@ -1,3 +1,7 @@
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "SegmentTree.hpp"
@@ -85,5 +89,363 @@ void test_SegmentTree() {
   }
 }
 
+// const 查询不 pushDown：与暴力结果对比，并且多个线程同时查询
+void test_SegmentTreeConstQuery() {
+  using Tree = SegmentTree<node, op, e, func, mapping, composition, id>;
+  RandomGenerator gen;
+  const int arr_len = 2000;
+  const int update_times = 3000;
+  const int num_range = 100000;
+  std::vector<node> ref(arr_len, node{0, 1});
+  Tree seg(ref);
+  const Tree &cseg = seg;
+  EXPECT_THROW(cseg.query(2, 1), std::out_of_range);
+  EXPECT_THROW(cseg.query(arr_len), std::out_of_range);
+  auto rangeSum = [&](int l, int r) {
+    long long ans = 0;
+    for (int j = l; j <= r; j++) {
+      ans = (ans + ref[j].a) % mod;
+    }
+    return ans;
+  };
+  for (int i = 0; i < update_times; i++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    func f{gen.uniform_int(0, num_range), gen.uniform_int(0, num_range)};
+    seg.apply(l, r, f);
+    for (int j = l; j <= r; j++) {
+      ref[j].a = (ref[j].a * f.a % mod + f.b) % mod;
+    }
+    int p = gen.uniform_int(0, arr_len - 1);
+    CHECK_EQ(ref[p].a, cseg.query(p).a);
+    CHECK_EQ(rangeSum(l, r), cseg.query(l, r).a);
+  }
+  // 树中仍留有未下传的标记，各线程只读
+  const int readers = 4;
+  const int reads = 2000;
+  std::vector<int> ok(readers, 1);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < readers; t++) {
+    threads.emplace_back([&, t]() {
+      RandomGenerator local(static_cast<unsigned>(t));
+      for (int i = 0; i < reads; i++) {
+        int l = local.uniform_int(0, arr_len - 1);
+        int r = local.uniform_int(0, arr_len - 1);
+        if (l > r) std::swap(l, r);
+        if (std::as_const(seg).query(l, r).a != rangeSum(l, r)) {
+          ok[t] = 0;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  CHECK_EQ(std::vector<int>(readers, 1), ok);
+}
+
+// 多线程建树与单线程建树的结果一致，长度不是 2 的幂
+void test_SegmentTreeParallelBuild() {
+  using Tree = SegmentTree<node, op, e, func, mapping, composition, id>;
+  RandomGenerator gen;
+  for (int arr_len : {1, 7, 1000, 4099}) {
+    std::vector<node> arr;
+    for (int i = 0; i < arr_len; i++) {
+      arr.push_back(node{gen.uniform_int(0, 100000), 1});
+    }
+    const Tree serial(arr);
+    for (unsigned threads : {0U, 2U, 3U, 8U}) {
+      const Tree parallel(arr, threads);
+      for (int q = 0; q < 200; q++) {
+        int l = gen.uniform_int(0, arr_len - 1);
+        int r = gen.uniform_int(0, arr_len - 1);
+        if (l > r) std::swap(l, r);
+        CHECK_EQ(serial.query(l, r).a, parallel.query(l, r).a);
+      }
+    }
+  }
+}
+
+// 批量修改与逐个修改的结果一致，包含重复下标
+void test_SegmentTreeBatch() {
+  using Tree = SegmentTree<node, op, e, func, mapping, composition, id>;
+  RandomGenerator gen;
+  const int arr_len = 3000;
+  const int rounds = 200;
+  std::vector<node> arr(arr_len, node{1, 1});
+  Tree batched(arr);
+  Tree single(arr);
+  EXPECT_THROW(batched.applyBatch({{0, id()}, {arr_len, id()}}),
+               std::out_of_range);
+  EXPECT_THROW(batched.assignBatch({{-1, e()}}), std::out_of_range);
+  for (int round = 0; round < rounds; round++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    // 先打上区间标记，让批量修改需要下传
+    func range_fn{gen.uniform_int(1, 10), gen.uniform_int(0, 10)};
+    batched.apply(l, r, range_fn);
+    single.apply(l, r, range_fn);
+    std::vector<std::pair<int64_t, func>> applies;
+    std::vector<std::pair<int64_t, node>> assigns;
+    int count = gen.uniform_int(0, 50);
+    for (int i = 0; i < count; i++) {
+      int64_t ind = gen.uniform_int(0, arr_len / 10);
+      applies.emplace_back(ind, func{gen.uniform_int(1, 10),
+                                     gen.uniform_int(0, 10)});
+      ind = gen.uniform_int(0, arr_len - 1);
+      assigns.emplace_back(ind, node{gen.uniform_int(0, 100), 1});
+    }
+    batched.applyBatch(applies);
+    for (const auto &item : applies) {
+      single.apply(item.first, item.second);
+    }
+    batched.assignBatch(assigns);
+    for (const auto &item : assigns) {
+      single.assign(item.first, item.second);
+    }
+    CHECK_EQ(single.query(l, r).a, batched.query(l, r).a);
+    CHECK_EQ(single.query(0, arr_len - 1).a, batched.query(0, arr_len - 1).a);
+  }
+  for (int i = 0; i < arr_len; i++) {
+    CHECK_EQ(single.query(i).a, batched.query(i).a);
+  }
+}
+
+namespace TestMonoidSegmentTree {
+// 仿射变换 x -> a x + b 的复合，不满足交换律，可以检验合并顺序
+struct affine {
+  long long a, b;
+};
+affine op(affine l, affine r) {
+  return affine{l.a * r.a % mod, (l.b * r.a + r.b) % mod};
+}
+affine e() { return affine{1, 0}; }
+}  // namespace TestMonoidSegmentTree
+
+void test_MonoidSegmentTree() {
+  namespace monoid = TestMonoidSegmentTree;
+  using monoid::affine;
+  RandomGenerator gen;
+  const int arr_len = 3000;
+  const int query_times = 30000;
+  const int num_range = 100000;
+  std::vector<affine> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(affine{gen.uniform_int(0, num_range),
+                         gen.uniform_int(0, num_range)});
+  }
+  MonoidSegmentTree<affine, monoid::op, monoid::e> seg(arr);
+  const auto &cseg = seg;
+  EXPECT_THROW(seg.assign(arr_len, affine{}), std::out_of_range);
+  EXPECT_THROW(cseg.query(2, 1), std::out_of_range);
+  EXPECT_THROW(cseg.query(-1), std::out_of_range);
+  for (int i = 0; i < query_times; i++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    if (gen.bernoulli(0.3)) {
+      affine val{gen.uniform_int(0, num_range), gen.uniform_int(0, num_range)};
+      seg.assign(l, val);
+      arr[l] = val;
+    } else {
+      affine ans = monoid::e();
+      for (int j = l; j <= r; j++) {
+        ans = monoid::op(ans, arr[j]);
+      }
+      affine got = cseg.query(l, r);
+      CHECK_EQ(ans.a, got.a);
+      CHECK_EQ(ans.b, got.b);
+      CHECK_EQ(arr[l].b, cseg.query(l).b);
+    }
+  }
+  affine all = monoid::e();
+  for (const auto &val : arr) {
+    all = monoid::op(all, val);
+  }
+  CHECK_EQ(all.b, cseg.queryAll().b);
+}
+
+namespace TestSegmentTreeSearch {
+// 区间加、区间求和，元素非负，前缀和关于区间单调
+struct sum_node {
+  long long sum;
+  int size;
+};
+sum_node op(sum_node l, sum_node r) {
+  return sum_node{l.sum + r.sum, l.size + r.size};
+}
+sum_node e() { return sum_node{0, 0}; }
+sum_node mapping(long long add, sum_node nd) {
+  return sum_node{nd.sum + add * nd.size, nd.size};
+}
+long long composition(long long f, long long g) { return f + g; }
+long long id() { return 0; }
+long long add(long long x, long long y) { return x + y; }
+long long zero() { return 0; }
+}  // namespace TestSegmentTreeSearch
+
+// 树上二分与从端点出发的暴力扫描对比
+void test_SegmentTreeSearch() {
+  namespace search = TestSegmentTreeSearch;
+  using search::sum_node;
+  RandomGenerator gen;
+  const int arr_len = 1000;
+  const int query_times = 20000;
+  std::vector<long long> ref(arr_len);
+  std::vector<sum_node> nodes;
+  for (int i = 0; i < arr_len; i++) {
+    ref[i] = gen.uniform_int(0, 10);
+    nodes.push_back(sum_node{ref[i], 1});
+  }
+  SegmentTree<sum_node, search::op, search::e, long long, search::mapping,
+              search::composition, search::id>
+      seg(nodes);
+  MonoidSegmentTree<long long, search::add, search::zero> plain(ref);
+  EXPECT_THROW(seg.maxRight(arr_len + 1, [](sum_node) { return true; }),
+               std::out_of_range);
+  EXPECT_THROW(plain.minLeft(arr_len, [](long long) { return true; }),
+               std::out_of_range);
+  CHECK_EQ(static_cast<int64_t>(arr_len),
+           seg.maxRight(arr_len, [](sum_node) { return false; }));
+  CHECK_EQ(int64_t{0}, plain.minLeft(-1, [](long long) { return false; }));
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    if (gen.bernoulli(0.3)) {
+      long long val = gen.uniform_int(0, 5);
+      seg.apply(l, r, val);
+      for (int j = l; j <= r; j++) {
+        ref[j] += val;
+        plain.assign(j, ref[j]);
+      }
+      continue;
+    }
+    long long budget = gen.uniform_int(0, 2000);
+    int64_t right = l;
+    for (long long sum = 0; right < arr_len; right++) {
+      sum += ref[right];
+      if (sum > budget) break;
+    }
+    int64_t left = r + 1;
+    for (long long sum = 0; left > 0; left--) {
+      sum += ref[left - 1];
+      if (sum > budget) break;
+    }
+    CHECK_EQ(right, seg.maxRight(l, [&](sum_node nd) {
+      return nd.sum <= budget;
+    }));
+    CHECK_EQ(right, plain.maxRight(l, [&](long long sum) {
+      return sum <= budget;
+    }));
+    CHECK_EQ(left, seg.minLeft(r, [&](sum_node nd) {
+      return nd.sum <= budget;
+    }));
+    CHECK_EQ(left, plain.minLeft(r, [&](long long sum) {
+      return sum <= budget;
+    }));
+  }
+}
+
+namespace TestSegmentTreeLarge {
+// 区间加、区间最大值，用 uint8_t 压缩内存
+uint8_t op(uint8_t l, uint8_t r) { return l > r ? l : r; }
+uint8_t e() { return 0; }
+uint8_t mapping(uint8_t fn, uint8_t x) { return static_cast<uint8_t>(x + fn); }
+uint8_t composition(uint8_t f, uint8_t g) {
+  return static_cast<uint8_t>(f + g);
+}
+uint8_t id() { return 0; }
+}  // namespace TestSegmentTreeLarge
+
+// 下标超过 2^31 的情形，约需 14 GiB 内存
+void test_SegmentTreeLarge() {
+  namespace large = TestSegmentTreeLarge;
+  using LargeTree = SegmentTree<uint8_t, large::op, large::e, uint8_t,
+                                large::mapping, large::composition, large::id>;
+  LargeTree small(10);
+  EXPECT_THROW(small.query(int64_t{1} << 32), std::out_of_range);
+  EXPECT_THROW(LargeTree(-1), std::invalid_argument);
+  if (!largeTestsEnabled()) {
+    return;
+  }
+  const int64_t base = int64_t{1} << 31;
+  const int64_t arr_len = base + 16;
+  LargeTree seg(arr_len);
+  CHECK_EQ(arr_len, seg.size());
+  seg.apply(base - 4, base + 4, 3);
+  seg.apply(base + 2, 7);
+  seg.assign(arr_len - 1, 9);
+  CHECK_EQ(uint8_t{3}, seg.query(0, base - 1));
+  CHECK_EQ(uint8_t{10}, seg.query(base, base + 8));
+  CHECK_EQ(uint8_t{0}, seg.query(base + 5, arr_len - 2));
+  CHECK_EQ(uint8_t{9}, seg.query(arr_len - 1));
+}
+
+// 区间覆盖与逐个赋值对比，覆盖前先打上区间标记，检验边界上的下传
+void test_SegmentTreeAssignRange() {
+  namespace monoid = TestMonoidSegmentTree;
+  using monoid::affine;
+  RandomGenerator gen;
+  const int arr_len = 1000;
+  const int query_times = 3000;
+  SegmentTree<node, op, e, func, mapping, composition, id> seg(
+      std::vector<node>(arr_len, node{1, 1}));
+  MonoidSegmentTree<affine, monoid::op, monoid::e> plain(arr_len);
+  std::vector<long long> ref(arr_len, 1);
+  std::vector<affine> plain_ref(arr_len, monoid::e());
+  EXPECT_THROW(seg.assignRange(-1, {}), std::out_of_range);
+  EXPECT_THROW(seg.assignRange(arr_len - 1, std::vector<node>(2)),
+               std::out_of_range);
+  EXPECT_THROW(plain.assignRange(arr_len + 1, {}), std::out_of_range);
+  EXPECT_THROW((MonoidSegmentTree<affine, monoid::op, monoid::e>(-1)),
+               std::invalid_argument);
+  seg.assignRange(arr_len, {});
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    func f{gen.uniform_int(1, 100), gen.uniform_int(0, 100)};
+    seg.apply(l, r, f);
+    for (int j = l; j <= r; j++) {
+      ref[j] = (ref[j] * f.a + f.b) % mod;
+    }
+    int from = gen.uniform_int(0, arr_len - 1);
+    int count = gen.uniform_int(0, arr_len - from);
+    std::vector<node> values;
+    std::vector<affine> plain_values;
+    for (int j = 0; j < count; j++) {
+      values.push_back(node{gen.uniform_int(0, 1000), 1});
+      plain_values.push_back(
+          affine{gen.uniform_int(0, 1000), gen.uniform_int(0, 1000)});
+      ref[from + j] = values.back().a;
+      plain_ref[from + j] = plain_values.back();
+    }
+    seg.assignRange(from, values);
+    plain.assignRange(from, plain_values);
+    long long sum = 0;
+    affine prod = monoid::e();
+    for (int j = l; j <= r; j++) {
+      sum += ref[j];
+      prod = monoid::op(prod, plain_ref[j]);
+    }
+    CHECK_EQ(sum % mod, seg.query(l, r).a);
+    CHECK_EQ(prod.a, plain.query(l, r).a);
+    CHECK_EQ(prod.b, plain.query(l, r).b);
+  }
+  for (int j = 0; j < arr_len; j++) {
+    CHECK_EQ(ref[j], seg.query(j).a);
+  }
+}
+
 // register tests
-MAKE_TEST(SegmentTree, Default) { test_SegmentTree(); }
\ No newline at end of file
+MAKE_TEST(SegmentTree, Default) { test_SegmentTree(); }
+MAKE_TEST(SegmentTree, Large) { test_SegmentTreeLarge(); }
+MAKE_TEST(SegmentTree, Monoid) { test_MonoidSegmentTree(); }
+MAKE_TEST(SegmentTree, ConstQuery) { test_SegmentTreeConstQuery(); }
+MAKE_TEST(SegmentTree, Search) { test_SegmentTreeSearch(); }
+MAKE_TEST(SegmentTree, ParallelBuild) { test_SegmentTreeParallelBuild(); }
+MAKE_TEST(SegmentTree, Batch) { test_SegmentTreeBatch(); }
+MAKE_TEST(SegmentTree, AssignRange) { test_SegmentTreeAssignRange(); }
\ No newline at end of file
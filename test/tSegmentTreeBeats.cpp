@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SegmentTreeBeats.hpp"
+#include "test.h"
+
+using namespace mystd::segment_tree;
+
+// 与暴力数组对比；值域较小，使大量元素同时等于最大值或最小值
+// 无符号类型的值域为 [0, num_range]，区间加只加非负数
+template <typename T>
+void test_random(int arr_len, T num_range) {
+  RandomGenerator gen;
+  const int query_times = 50000;
+  const T low = std::is_signed_v<T> ? T{} - num_range : T{};
+  std::vector<T> ref;
+  for (int i = 0; i < arr_len; i++) {
+    ref.push_back(gen.uniform_int(low, num_range));
+  }
+  SegmentTreeBeats<T> tree(ref);
+  CHECK_EQ(int64_t{arr_len}, tree.size());
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    T val = gen.uniform_int(low, num_range);
+    switch (gen.uniform_int(0, 6)) {
+      case 0:
+        tree.chmin(l, r, val);
+        for (int i = l; i <= r; i++) {
+          ref[i] = std::min(ref[i], val);
+        }
+        break;
+      case 1:
+        tree.chmax(l, r, val);
+        for (int i = l; i <= r; i++) {
+          ref[i] = std::max(ref[i], val);
+        }
+        break;
+      case 2:
+        tree.add(l, r, val / 4);
+        for (int i = l; i <= r; i++) {
+          ref[i] += val / 4;
+        }
+        break;
+      case 3:
+        tree.assign(l, val);
+        ref[l] = val;
+        break;
+      case 4: {
+        T sum = 0;
+        for (int i = l; i <= r; i++) {
+          sum += ref[i];
+        }
+        CHECK_EQ(sum, tree.querySum(l, r));
+        break;
+      }
+      case 5:
+        CHECK_EQ(*std::max_element(ref.begin() + l, ref.begin() + r + 1),
+                 tree.queryMax(l, r));
+        break;
+      default:
+        CHECK_EQ(*std::min_element(ref.begin() + l, ref.begin() + r + 1),
+                 tree.queryMin(l, r));
+        break;
+    }
+  }
+  for (int i = 0; i < arr_len; i++) {
+    CHECK_EQ(ref[i], tree.query(i));
+  }
+}
+
+static void test_bounds() {
+  SegmentTreeBeats<int> tree(5);
+  EXPECT_THROW(tree.chmin(0, 5, 1), std::out_of_range);
+  EXPECT_THROW(tree.chmax(-1, 2, 1), std::out_of_range);
+  EXPECT_THROW(tree.add(3, 2, 1), std::out_of_range);
+  EXPECT_THROW(tree.assign(5, 1), std::out_of_range);
+  EXPECT_THROW(tree.querySum(0, 5), std::out_of_range);
+  EXPECT_THROW(tree.queryMax(2, 1), std::out_of_range);
+  EXPECT_THROW(tree.queryMin(-1, 0), std::out_of_range);
+  // 只有一个元素时没有次大值、次小值
+  SegmentTreeBeats<int> single(std::vector<int>{3});
+  single.chmin(0, 0, 1);
+  single.chmax(0, 0, 2);
+  CHECK_EQ(2, single.query(0));
+  CHECK_EQ(2, single.queryMax(0, 0));
+  CHECK_EQ(2, single.queryMin(0, 0));
+  // 无符号数中 0 是合法元素，不能当作“没有次大值”的标记
+  SegmentTreeBeats<unsigned> zero(std::vector<unsigned>{0, 5});
+  zero.add(0, 1, 3);
+  zero.chmin(0, 1, 4);
+  zero.chmin(0, 1, 2);
+  CHECK_EQ(2U, zero.query(0));
+  CHECK_EQ(2U, zero.query(1));
+  CHECK_EQ(4U, zero.querySum(0, 1));
+  SegmentTreeBeats<int> empty_tree(0);
+  CHECK_EQ(int64_t{0}, empty_tree.size());
+  EXPECT_THROW(empty_tree.query(0), std::out_of_range);
+}
+
+// register tests
+MAKE_TEST(SegmentTreeBeats, Random) {
+  test_random<int64_t>(1, 10);
+  test_random<int64_t>(257, 5);
+  test_random<int64_t>(1000, 1000000);
+  test_random<uint64_t>(257, 5);
+  test_random<uint64_t>(1000, 1000000);
+}
+MAKE_TEST(SegmentTreeBeats, Bounds) { test_bounds(); }
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "FenwickTree.hpp"
+#include "SparseFenwickTree.hpp"
+#include "common.h"
+#include "test.h"
+
+using namespace mystd::fenwick_tree;
+
+// 闭区间 [l, r] 内所有键的和
+static auto rangeSum(const std::map<uint64_t, long long> &ref, uint64_t l,
+                     uint64_t r) -> long long {
+  long long ans = 0;
+  for (auto it = ref.lower_bound(l); it != ref.end() && it->first <= r; ++it) {
+    ans += it->second;
+  }
+  return ans;
+}
+
+// 在整个 64 位空间内随机取点，同时包含靠近两端的下标
+static auto randomKey(RandomGenerator &gen) -> uint64_t {
+  switch (gen.uniform_int(0, 2)) {
+    case 0:
+      return gen.uniform_int(0ULL, 100ULL);
+    case 1:
+      return UINT64_MAX - 1 - gen.uniform_int(0ULL, 100ULL);
+    default:
+      return gen.uniform_int(0ULL, UINT64_MAX - 1);
+  }
+}
+
+static void test_sparse() {
+  RandomGenerator gen;
+  const int query_times = 20000;
+  SparseFenwickTree<group::Sum<long long>> tree;
+  std::map<uint64_t, long long> ref;
+  EXPECT_THROW(tree.apply(UINT64_MAX, 1), std::out_of_range);
+  EXPECT_THROW(tree.query(5, 4), std::out_of_range);
+  CHECK_EQ(0LL, tree.query(0, UINT64_MAX - 1));
+  for (int q = 0; q < query_times; q++) {
+    uint64_t l = randomKey(gen);
+    uint64_t r = randomKey(gen);
+    if (l > r) mystd::swap(l, r);
+    if (gen.bernoulli(0.5)) {
+      long long val = gen.uniform_int(-1000, 1000);
+      tree.apply(l, val);
+      ref[l] += val;
+    } else {
+      CHECK_EQ(rangeSum(ref, l, r), tree.query(l, r));
+    }
+  }
+  // 每次修改最多新建 64 个结点
+  CHECK_EQ(true, tree.nodeCount() <= ref.size() * 64);
+
+  SparseFenwickTree<group::Xor<uint32_t>> small(10);
+  small.apply(9, 6);
+  small.apply(3, 5);
+  CHECK_EQ(3u, small.query(9));
+  CHECK_EQ(6u, small.query(4, 9));
+  EXPECT_THROW(small.apply(10, 1), std::out_of_range);
+}
+
+static void test_compressed() {
+  RandomGenerator gen;
+  const int key_count = 2000;
+  const int query_times = 20000;
+  std::vector<uint64_t> keys;
+  std::vector<long long> values;
+  std::map<uint64_t, long long> ref;
+  for (int i = 0; i < key_count; i++) {
+    // 有意产生重复的键
+    uint64_t key = i % 3 == 0 && !keys.empty() ? keys.back() : randomKey(gen);
+    long long val = gen.uniform_int(-1000, 1000);
+    keys.push_back(key);
+    values.push_back(val);
+    ref[key] += val;
+  }
+  CompressedFenwickTree<group::Sum<long long>> tree(keys, values);
+  CHECK_EQ(static_cast<int>(ref.size()), tree.size());
+  EXPECT_THROW(tree.query(5, 4), std::out_of_range);
+  EXPECT_THROW(CompressedFenwickTree<group::Sum<long long>>(keys, {1}),
+               std::invalid_argument);
+  for (int q = 0; q < query_times; q++) {
+    if (gen.bernoulli(0.5)) {
+      uint64_t key = keys[gen.uniform_int(0, key_count - 1)];
+      long long val = gen.uniform_int(-1000, 1000);
+      tree.apply(key, val);
+      ref[key] += val;
+    } else {
+      // 查询的端点不必是已知的键
+      uint64_t l = randomKey(gen);
+      uint64_t r = randomKey(gen);
+      if (l > r) mystd::swap(l, r);
+      CHECK_EQ(rangeSum(ref, l, r), tree.query(l, r));
+    }
+  }
+  uint64_t unknown = 0;
+  while (tree.contains(unknown)) {
+    unknown++;
+  }
+  EXPECT_THROW(tree.apply(unknown, 1), std::out_of_range);
+}
+
+// register tests
+MAKE_TEST(SparseFenwickTree, Sparse) { test_sparse(); }
+MAKE_TEST(SparseFenwickTree, Compressed) { test_compressed(); }
@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "SparseTable.hpp"
+#include "test.h"
+
+using namespace mystd::sparse_table;
+
+namespace TestSparseTable {
+int64_t minOp(int64_t lhs, int64_t rhs) { return lhs < rhs ? lhs : rhs; }
+int64_t gcdOp(int64_t lhs, int64_t rhs) { return std::gcd(lhs, rhs); }
+uint32_t orOp(uint32_t lhs, uint32_t rhs) { return lhs | rhs; }
+}  // namespace TestSparseTable
+using namespace TestSparseTable;
+
+// 与暴力区间折叠对比；长度覆盖 1、不满一块和不是 2 的幂的情况
+template <typename Table, typename T, T (*op)(T, T)>
+void test_table(int arr_len, int num_range) {
+  RandomGenerator gen;
+  const int query_times = 20000;
+  std::vector<T> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(static_cast<T>(gen.uniform_int(1, num_range)));
+  }
+  const Table table(arr);
+  CHECK_EQ(int64_t{arr_len}, table.size());
+  EXPECT_THROW(table.query(arr_len), std::out_of_range);
+  EXPECT_THROW(table.query(-1, 0), std::out_of_range);
+  EXPECT_THROW(table.query(0, arr_len), std::out_of_range);
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    T ans = arr[l];
+    for (int i = l + 1; i <= r; i++) {
+      ans = op(ans, arr[i]);
+    }
+    CHECK_EQ(ans, table.query(l, r));
+    CHECK_EQ(arr[l], table.query(l));
+  }
+}
+
+// register tests
+MAKE_TEST(SparseTable, Min) {
+  for (int arr_len : {1, 31, 1000}) {
+    test_table<SparseTable<int64_t, minOp>, int64_t, minOp>(arr_len, 1000000);
+  }
+}
+MAKE_TEST(SparseTable, GcdAndOr) {
+  test_table<SparseTable<int64_t, gcdOp>, int64_t, gcdOp>(777, 64);
+  test_table<SparseTable<uint32_t, orOp>, uint32_t, orOp>(777, 1 << 20);
+}
+MAKE_TEST(SparseTable, Block) {
+  for (int arr_len : {1, 31, 32, 33, 1000}) {
+    test_table<BlockSparseTable<int64_t, minOp>, int64_t, minOp>(arr_len,
+                                                                 1000000);
+    test_table<BlockSparseTable<int64_t, gcdOp, 5>, int64_t, gcdOp>(arr_len,
+                                                                    64);
+  }
+  const BlockSparseTable<int64_t, minOp> empty_table({});
+  CHECK_EQ(int64_t{0}, empty_table.size());
+  EXPECT_THROW(empty_table.query(0, 0), std::out_of_range);
+}
@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "TimerWheel.hpp"
+#include "test.h"
+
+using namespace mystd::timer_wheel;
+
+static void test_basic() {
+  TimerWheel<> wheel(100);
+  std::vector<int> order;
+  wheel.schedule(105, [&]() { order.push_back(5); });
+  wheel.schedule(103, [&]() { order.push_back(3); });
+  auto handle = wheel.schedule(104, [&]() { order.push_back(4); });
+  // 已过期的定时器在下一个 tick 触发
+  wheel.schedule(50, [&]() { order.push_back(0); });
+  CHECK_EQ(4u, wheel.size());
+  CHECK_EQ(true, wheel.cancel(handle));
+  CHECK_EQ(false, wheel.cancel(handle));
+  CHECK_EQ(0u, wheel.advance(100));
+  CHECK_EQ(1u, wheel.advance(101));
+  CHECK_EQ(2u, wheel.advance(1000));
+  CHECK_EQ((std::vector<int>{0, 3, 5}), order);
+  CHECK_EQ(true, wheel.empty());
+  CHECK_EQ(static_cast<uint64_t>(1000), wheel.now());
+
+  // 回调中重新调度
+  int count = 0;
+  TimerWheel<> periodic;
+  std::function<void()> tick = [&]() {
+    count++;
+    if (count < 10) {
+      periodic.schedule(periodic.now() + 7, tick);
+    }
+  };
+  periodic.schedule(7, tick);
+  periodic.advance(69);
+  CHECK_EQ(9, count);
+  periodic.advance(70);
+  CHECK_EQ(10, count);
+  CHECK_EQ(true, periodic.empty());
+}
+
+static void test_random() {
+  RandomGenerator gen;
+  TimerWheel<> wheel;
+  // id -> 应当触发的 tick
+  std::map<int, uint64_t> expected;
+  std::vector<TimerHandle> handles;
+  std::vector<bool> alive;
+  int fired_count = 0;
+  bool ok = true;
+  const int rounds = 20000;
+  for (int r = 0; r < rounds; r++) {
+    int opt = gen.uniform_int(0, 9);
+    if (opt < 6) {
+      // 跨度覆盖各层以及溢出桶
+      int span_bits = gen.uniform_int(0, 30);
+      uint64_t delta = gen.uniform_int(0ULL, 1ULL << span_bits);
+      uint64_t deadline = wheel.now() + delta;
+      int id = static_cast<int>(handles.size());
+      uint64_t effective = deadline > wheel.now() ? deadline : wheel.now() + 1;
+      handles.push_back(wheel.schedule(deadline, [&, id, effective]() {
+        ok = ok && alive[id] && wheel.now() == effective;
+        alive[id] = false;
+        fired_count++;
+      }));
+      alive.push_back(true);
+      expected[id] = effective;
+    } else if (opt < 8) {
+      if (handles.empty()) continue;
+      int id = gen.uniform_int(0, static_cast<int>(handles.size()) - 1);
+      bool was_alive = alive[id];
+      CHECK_EQ(was_alive, wheel.cancel(handles[id]));
+      alive[id] = false;
+    } else {
+      uint64_t target =
+          wheel.now() + gen.uniform_int(0ULL, 1ULL << gen.uniform_int(0, 26));
+      int before = fired_count;
+      size_t fired = wheel.advance(target);
+      CHECK_EQ(static_cast<size_t>(fired_count - before), fired);
+      for (size_t id = 0; id < alive.size(); id++) {
+        if (alive[id] && expected[static_cast<int>(id)] <= target) {
+          ok = false;
+        }
+      }
+    }
+    CHECK_EQ(true, ok);
+  }
+  size_t remaining = 0;
+  for (bool a : alive) {
+    remaining += a ? 1 : 0;
+  }
+  CHECK_EQ(remaining, wheel.size());
+  wheel.advance(UINT64_MAX / 2);
+  CHECK_EQ(true, ok);
+  CHECK_EQ(true, wheel.empty());
+}
+
+// register tests
+MAKE_TEST(TimerWheel, Basic) { test_basic(); }
+MAKE_TEST(TimerWheel, Random) { test_random(); }
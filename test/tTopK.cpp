@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+#include "Compare.hpp"
+#include "TopK.hpp"
+#include "test.h"
+
+using namespace mystd::top_k;
+using namespace mystd::compare;
+
+template <typename Sel>
+static auto toStd(const Sel &sel) -> std::vector<int> {
+  auto res = sel.sorted();
+  return std::vector<int>(res.cbegin(), res.cend());
+}
+
+static void test_basic() {
+  TopK<int, 3> sel;
+  CHECK_EQ(true, sel.empty());
+  EXPECT_THROW(sel.threshold(), std::out_of_range);
+  CHECK_EQ(true, sel.offer(5));
+  CHECK_EQ(true, sel.offer(1));
+  CHECK_EQ(true, sel.offer(3));
+  CHECK_EQ(true, sel.full());
+  CHECK_EQ(1, sel.threshold());
+  CHECK_EQ(false, sel.offer(0));
+  CHECK_EQ(false, sel.offer(1));
+  CHECK_EQ(true, sel.offer(4));
+  CHECK_EQ(3, sel.threshold());
+  CHECK_EQ((std::vector<int>{5, 4, 3}), toStd(sel));
+
+  TopK<int, 2, Greater<int>> small;
+  for (int x : {7, 2, 9, 1, 8}) {
+    small.offer(x);
+  }
+  CHECK_EQ((std::vector<int>{1, 2}), toStd(small));
+}
+
+static void test_random_stream() {
+  RandomGenerator gen;
+  const int len = 100000;
+  const int num_range = 1000000;
+  std::vector<int> arr;
+  for (int i = 0; i < len; i++) {
+    arr.push_back(gen.uniform_int(-num_range, num_range));
+  }
+  std::vector<int> ref = arr;
+  std::sort(ref.begin(), ref.end(), std::greater<int>());
+  ref.resize(100);
+
+  TopK<int, 100> single;
+  for (int x : arr) {
+    single.offer(x);
+  }
+  CHECK_EQ(ref, toStd(single));
+
+  TopK<int, 100> batch;
+  batch.offer(arr.begin(), arr.end());
+  CHECK_EQ(ref, toStd(batch));
+
+  // 非随机访问迭代器走逐个接收的路径
+  std::list<int> lst(arr.begin(), arr.end());
+  TopK<int, 100> from_list;
+  from_list.offer(lst.begin(), lst.end());
+  CHECK_EQ(ref, toStd(from_list));
+}
+
+static void test_merge() {
+  RandomGenerator gen;
+  const int parts = 8;
+  const int part_len = 10007;
+  std::vector<int> all;
+  TopK<int, 50, Greater<int>> merged;
+  for (int p = 0; p < parts; p++) {
+    std::vector<int> arr;
+    for (int i = 0; i < part_len; i++) {
+      arr.push_back(gen.uniform_int(0, 1000000));
+    }
+    all.insert(all.end(), arr.begin(), arr.end());
+    TopK<int, 50, Greater<int>> local;
+    local.offer(arr.begin(), arr.end());
+    merged.mergeFrom(local);
+  }
+  std::sort(all.begin(), all.end());
+  all.resize(50);
+  CHECK_EQ(all, toStd(merged));
+
+  // 与自身合并等价于输入重复一遍
+  TopK<int, 4> twice;
+  std::vector<int> five{5, 1, 4, 2, 3};
+  twice.offer(five.begin(), five.end());
+  twice.mergeFrom(twice);
+  CHECK_EQ((std::vector<int>{5, 5, 4, 4}), toStd(twice));
+
+  TopK<int, 10> few;
+  std::vector<int> three{3, 1, 2};
+  CHECK_EQ(3u, few.offer(three.begin(), three.end()));
+  CHECK_EQ((std::vector<int>{3, 2, 1}), toStd(few));
+}
+
+// register tests
+MAKE_TEST(TopK, Basic) { test_basic(); }
+MAKE_TEST(TopK, RandomStream) { test_random_stream(); }
+MAKE_TEST(TopK, Merge) { test_merge(); }
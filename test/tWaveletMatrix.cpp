@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Vector.hpp"
+#include "WaveletMatrix.hpp"
+#include "test.h"
+
+using namespace mystd::wavelet_matrix;
+
+// 与排序后的暴力结果对比，查询值可能小于所有元素或大于所有元素
+template <typename T>
+void test_WaveletMatrix(int arr_len, int64_t lo, int64_t hi) {
+  RandomGenerator gen;
+  const int query_times = 5000;
+  std::vector<T> arr;
+  for (int i = 0; i < arr_len; i++) {
+    arr.push_back(static_cast<T>(gen.uniform_int(lo, hi)));
+  }
+  const WaveletMatrix<T> wm(arr);
+  CHECK_EQ(int64_t{arr_len}, wm.size());
+  EXPECT_THROW(wm.kth(0, arr_len, 0), std::out_of_range);
+  EXPECT_THROW(wm.kth(0, 0, 1), std::out_of_range);
+  EXPECT_THROW(wm.rank(1, 0, T{}), std::out_of_range);
+  for (int i = 0; i < arr_len; i++) {
+    CHECK_EQ(arr[i], wm.access(i));
+  }
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    std::vector<T> sorted(arr.begin() + l, arr.begin() + r + 1);
+    std::sort(sorted.begin(), sorted.end());
+    int k = gen.uniform_int(0, r - l);
+    CHECK_EQ(sorted[k], wm.kth(l, r, k));
+    auto x = static_cast<T>(gen.uniform_int(lo, hi));
+    auto y = static_cast<T>(gen.uniform_int(lo, hi));
+    auto less = std::lower_bound(sorted.begin(), sorted.end(), x) -
+                sorted.begin();
+    CHECK_EQ(static_cast<int64_t>(less), wm.rank(l, r, x));
+    int64_t freq = 0;
+    for (T val : sorted) {
+      freq += x <= val && val < y ? 1 : 0;
+    }
+    CHECK_EQ(freq, wm.rangeFreq(l, r, x, y));
+  }
+}
+
+static void test_edge() {
+  // 所有元素相等时没有位向量
+  const WaveletMatrix<uint32_t> zeros(std::vector<uint32_t>(10, 0));
+  CHECK_EQ(0, zeros.levels());
+  CHECK_EQ(0U, zeros.kth(0, 9, 9));
+  CHECK_EQ(int64_t{10}, zeros.rank(0, 9, 1));
+  CHECK_EQ(int64_t{0}, zeros.rank(0, 9, 0));
+  // 超过最大值的查询
+  mystd::vector::Vector<uint64_t> vec;
+  vec.pushBack(5);
+  vec.pushBack(UINT64_MAX);
+  vec.pushBack(3);
+  const WaveletMatrix<uint64_t> wide(vec);
+  CHECK_EQ(64, wide.levels());
+  CHECK_EQ(UINT64_MAX, wide.kth(0, 2, 2));
+  CHECK_EQ(int64_t{2}, wide.rank(0, 2, UINT64_MAX));
+  CHECK_EQ(int64_t{1}, wide.rangeFreq(0, 2, 4, 100));
+  CHECK_EQ(int64_t{0}, wide.rangeFreq(0, 2, 100, 4));
+  // 层数只取决于 max - min，与符号和偏移无关
+  const WaveletMatrix<int> small(std::vector<int>{-50, 7, 50, -3});
+  CHECK_EQ(7, small.levels());
+  CHECK_EQ(-50, small.kth(0, 3, 0));
+  CHECK_EQ(int64_t{0}, small.rank(0, 3, -50));
+  CHECK_EQ(int64_t{0}, small.rank(0, 3, INT32_MIN));
+  CHECK_EQ(int64_t{4}, small.rank(0, 3, INT32_MAX));
+  CHECK_EQ(int64_t{2}, small.rangeFreq(0, 3, -100, 0));
+  const WaveletMatrix<uint32_t> shifted(std::vector<uint32_t>{1000, 1003});
+  CHECK_EQ(2, shifted.levels());
+  CHECK_EQ(1003U, shifted.access(1));
+  CHECK_EQ(int64_t{1}, shifted.rank(0, 1, 1001));
+  const WaveletMatrix<int64_t> full(std::vector<int64_t>{INT64_MAX, INT64_MIN});
+  CHECK_EQ(64, full.levels());
+  CHECK_EQ(INT64_MIN, full.kth(0, 1, 0));
+  CHECK_EQ(INT64_MAX, full.access(0));
+  CHECK_EQ(int64_t{1}, full.rank(0, 1, INT64_MAX));
+  const WaveletMatrix<int> empty_wm(std::vector<int>{});
+  EXPECT_THROW(empty_wm.access(0), std::out_of_range);
+}
+
+// register tests
+MAKE_TEST(WaveletMatrix, Unsigned) {
+  test_WaveletMatrix<uint32_t>(1, 0, 100);
+  test_WaveletMatrix<uint32_t>(1000, 0, 15);
+  test_WaveletMatrix<uint64_t>(1000, 0, int64_t{1} << 40);
+}
+MAKE_TEST(WaveletMatrix, Signed) {
+  test_WaveletMatrix<int>(1000, -50, 50);
+  test_WaveletMatrix<int64_t>(777, INT64_MIN / 2, INT64_MAX / 2);
+}
+MAKE_TEST(WaveletMatrix, Edge) { test_edge(); }
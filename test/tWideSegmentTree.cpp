@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "WideSegmentTree.hpp"
+#include "test.h"
+
+using namespace mystd::segment_tree;
+
+// 与朴素数组对比；长度覆盖 16 的幂的边界
+template <typename T>
+void test_WideSegmentTree(int arr_len) {
+  RandomGenerator gen;
+  const int query_times = 20000;
+  const int num_range = 1000;
+  std::vector<T> ref;
+  for (int i = 0; i < arr_len; i++) {
+    ref.push_back(static_cast<T>(gen.uniform_int(-num_range, num_range)));
+  }
+  WideSegmentTree<T> tree(ref);
+  CHECK_EQ(int64_t{arr_len}, tree.size());
+  EXPECT_THROW(tree.apply(arr_len, T{}), std::out_of_range);
+  EXPECT_THROW(tree.prefix(-2), std::out_of_range);
+  EXPECT_THROW(tree.query(1, 0), std::out_of_range);
+  CHECK_EQ(T{}, tree.prefix(-1));
+  for (int q = 0; q < query_times; q++) {
+    int l = gen.uniform_int(0, arr_len - 1);
+    int r = gen.uniform_int(0, arr_len - 1);
+    if (l > r) std::swap(l, r);
+    auto val = static_cast<T>(gen.uniform_int(-num_range, num_range));
+    switch (gen.uniform_int(0, 3)) {
+      case 0:
+        tree.apply(l, val);
+        ref[l] += val;
+        break;
+      case 1:
+        tree.assign(l, val);
+        ref[l] = val;
+        break;
+      case 2: {
+        T ans{};
+        for (int i = 0; i <= r; i++) {
+          ans += ref[i];
+        }
+        CHECK_EQ(ans, tree.prefix(r));
+        break;
+      }
+      default: {
+        T ans{};
+        for (int i = l; i <= r; i++) {
+          ans += ref[i];
+        }
+        CHECK_EQ(ans, tree.query(l, r));
+        break;
+      }
+    }
+  }
+}
+
+// register tests
+MAKE_TEST(WideSegmentTree, Int32) {
+  for (int arr_len : {1, 15, 16, 17, 255, 256, 1000, 4097}) {
+    test_WideSegmentTree<int32_t>(arr_len);
+  }
+}
+MAKE_TEST(WideSegmentTree, OtherTypes) {
+  test_WideSegmentTree<int64_t>(4097);
+  test_WideSegmentTree<uint32_t>(300);
+  test_WideSegmentTree<double>(300);
+  WideSegmentTree<int> empty_tree(0);
+  CHECK_EQ(1, empty_tree.height());
+  CHECK_EQ(0, empty_tree.prefix(-1));
+}